@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <daedalus/dungeon.hpp>
+#include <daedalus/pathfinding.hpp>
+#include <vector>
+
+/**
+ * @file dungeon_bench.cpp
+ * @brief Benchmarks for dungeon generation, pathfinding and tile access.
+ */
+
+using namespace daedalus;
+
+static void BM_GenerateNaive(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GenerateNaive)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_GenerateCellularAutomata(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::CELLULAR_AUTOMATA);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GenerateCellularAutomata)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_GenerateBsp(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::BSP);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GenerateBsp)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_GenerateDrunkenWalk(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::DRUNKEN_WALK);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GenerateDrunkenWalk)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_GenerateVoronoi(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::VORONOI);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GenerateVoronoi)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_GeneratePerlinNoise(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon(DungeonGenerationMethod::PERLIN_NOISE);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_GeneratePerlinNoise)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_CellularAutomataStep(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::CELLULAR_AUTOMATA);
+    for (auto _ : state) {
+        dungeon.generate_random_dungeon_cellular_automata_step();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_CellularAutomataStep)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_FindPath(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    PathfindingContext ctx;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dungeon.find_path(dungeon.entrance_pos(), dungeon.exit_pos(), ctx));
+    }
+}
+BENCHMARK(BM_FindPath)->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_ComputeFlowField(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    for (auto _ : state) {
+        FlowField field = dungeon.compute_flow_field(dungeon.exit_pos());
+        benchmark::DoNotOptimize(field.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ComputeFlowField)->Arg(64)->Arg(256)->Arg(512);
+
+static void BM_ExportData(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    std::vector<std::uint8_t> out;
+    for (auto _ : state) {
+        dungeon.export_data(out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ExportData)->Arg(256)->Arg(1024);
+
+static void BM_TilesView(benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    RogueDungeon dungeon(size, size, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    for (auto _ : state) {
+        // The zero-copy counterpart of BM_ExportData: walk every row
+        // through the view without materializing a copy
+        std::size_t walls = 0;
+        for (std::size_t i = 0; i < dungeon.rows(); i++) {
+            const std::uint8_t* row = dungeon.row(i);
+            for (std::size_t j = 0; j < dungeon.cols(); j++) {
+                walls += (row[j] == 0);
+            }
+        }
+        benchmark::DoNotOptimize(walls);
+    }
+    state.SetBytesProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_TilesView)->Arg(256)->Arg(1024);
+
+static void BM_SetTile(benchmark::State& state) {
+    RogueDungeon dungeon(256, 256, 42);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < 256; i++) {
+            for (std::size_t j = 0; j < 256; j++) {
+                dungeon.set_tile(i, j, 1);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 256 * 256);
+}
+BENCHMARK(BM_SetTile);
+
+static void BM_TileRead(benchmark::State& state) {
+    RogueDungeon dungeon(256, 256, 42);
+    dungeon.generate_random_dungeon(DungeonGenerationMethod::NAIVE);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < 256; i++) {
+            for (std::size_t j = 0; j < 256; j++) {
+                sum += dungeon(i, j);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 256 * 256);
+}
+BENCHMARK(BM_TileRead);
+
+BENCHMARK_MAIN();
@@ -1,73 +1,488 @@
+#pragma once
+
 /**
  * @file array_2D.hpp
  * @brief A 2D array implementation using a single vector for storage.
  */
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace daedalus {
 
+    /**
+     * @struct RowMajorLayout
+     * @brief The default storage layout: rows are contiguous.
+     *
+     * Ideal for row scans, exports and memset-speed fills.
+     */
+    struct RowMajorLayout {
+        static constexpr bool row_contiguous = true; /**< Rows are contiguous in storage */
+
+        /**
+         * @brief Storage elements needed for the given dimensions.
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @return rows * cols.
+         */
+        static std::size_t storage_size(std::size_t rows, std::size_t cols) {
+            return rows * cols;
+        }
+
+        /**
+         * @brief Storage index of an element.
+         * @param i The row index.
+         * @param j The column index.
+         * @param cols The number of columns.
+         * @return The storage index.
+         */
+        static std::size_t index(std::size_t i, std::size_t j, std::size_t cols) {
+            return i * cols + j;
+        }
+    };
+
+    /**
+     * @struct MortonLayout
+     * @brief Z-order (Morton curve) storage layout.
+     *
+     * Interleaves the row and column bits through a lookup table, so the
+     * 4-neighborhood of a tile usually shares a cache line with it -
+     * vertical neighbors are no longer a whole row apart. Storage is
+     * padded to a power-of-two square, so this trades memory for
+     * locality; best for maps whose dominant access is neighborhood
+     * queries rather than row scans. Rows are not contiguous: row(),
+     * data() and the contiguous fast paths do not apply.
+     */
+    struct MortonLayout {
+        static constexpr bool row_contiguous = false; /**< Rows are scattered in storage */
+
+        /**
+         * @brief Storage elements needed for the given dimensions.
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @return The padded power-of-two square size.
+         */
+        static std::size_t storage_size(std::size_t rows, std::size_t cols) {
+            std::size_t side = 1;
+            while (side < rows || side < cols) {
+                side *= 2;
+            }
+            return side * side;
+        }
+
+        /**
+         * @brief Storage index of an element: the bits of i and j interleaved.
+         * @param i The row index.
+         * @param j The column index.
+         * @param cols The number of columns (unused; the curve is dimension-free).
+         * @return The storage index.
+         */
+        static std::size_t index(std::size_t i, std::size_t j, std::size_t cols) {
+            (void)cols;
+            return (spread(i) << 1) | spread(j);
+        }
+
+    private:
+        /**
+         * @brief Spreads the low 16 bits of a value to the even bit positions.
+         * @param x The value to spread.
+         * @return The spread value.
+         */
+        static std::size_t spread(std::size_t x) {
+            static const std::uint16_t* lut = [] {
+                static std::uint16_t table[256];
+                for (std::uint32_t b = 0; b < 256; b++) {
+                    std::uint32_t spread_bits = 0;
+                    for (int k = 0; k < 8; k++) {
+                        spread_bits |= ((b >> k) & 1u) << (2 * k);
+                    }
+                    table[b] = static_cast<std::uint16_t>(spread_bits);
+                }
+                return table;
+            }();
+            return static_cast<std::size_t>(lut[x & 0xFF])
+                 | (static_cast<std::size_t>(lut[(x >> 8) & 0xFF]) << 16);
+        }
+    };
+
     /**
      * @class Array_2D
      * @brief A template class for a 2D array.
-     * 
+     *
      * This class provides a 2D array interface using a single vector for storage.
-     * 
+     *
      * @tparam T The type of elements stored in the array.
+     * @tparam Allocator The allocator the storage is obtained from.
+     * @tparam Layout The storage layout policy; row-major by default, with
+     *         MortonLayout available for neighborhood-heavy access patterns.
      */
-    template <typename T>
+    template <typename T, typename Allocator = std::allocator<T>, typename Layout = RowMajorLayout>
     class Array_2D {
     public:
         /**
          * @brief Constructs a 2D array with the given number of rows and columns.
-         * 
+         *
+         * Elements are value-initialized.
+         *
          * @param rows The number of rows in the array.
          * @param cols The number of columns in the array.
          */
-        Array_2D(std::size_t rows, std::size_t cols);
+        Array_2D(std::size_t rows, std::size_t cols) :
+        rows_(rows),
+        cols_(cols),
+        data_(Layout::storage_size(rows, cols)) {
+        };
+
+        /**
+         * @brief Constructs a 2D array whose storage comes from the given allocator.
+         *
+         * @param rows The number of rows in the array.
+         * @param cols The number of columns in the array.
+         * @param allocator The allocator to obtain the storage from.
+         */
+        Array_2D(std::size_t rows, std::size_t cols, const Allocator& allocator) :
+        rows_(rows),
+        cols_(cols),
+        data_(Layout::storage_size(rows, cols), T(), allocator) {
+        };
+
+        Array_2D(const Array_2D&) = default;
+        Array_2D& operator=(const Array_2D&) = default;
+
+        /**
+         * @brief Move constructor; steals the storage, no copy.
+         *
+         * The moved-from array is left 0x0 so its extents agree with its
+         * emptied storage.
+         *
+         * @param other The array to move from.
+         */
+        Array_2D(Array_2D&& other) noexcept :
+        rows_(std::exchange(other.rows_, 0)),
+        cols_(std::exchange(other.cols_, 0)),
+        data_(std::move(other.data_)),
+        dirty_rows_(std::move(other.dirty_rows_)),
+        generation_(other.generation_) {
+        };
+
+        /**
+         * @brief Move assignment; steals the storage, no copy.
+         *
+         * The moved-from array is left 0x0 so its extents agree with its
+         * emptied storage.
+         *
+         * @param other The array to move from.
+         * @return Reference to this array.
+         */
+        Array_2D& operator=(Array_2D&& other) noexcept {
+            rows_ = std::exchange(other.rows_, 0);
+            cols_ = std::exchange(other.cols_, 0);
+            data_ = std::move(other.data_);
+            dirty_rows_ = std::move(other.dirty_rows_);
+            generation_ = other.generation_;
+            return *this;
+        }
 
         /**
          * @brief Accesses the element at the given row and column.
-         * 
+         *
          * @param i The row index.
          * @param j The column index.
          * @return A reference to the element at the specified position.
          */
-        T& operator()(std::size_t i, std::size_t j);
+        T& operator()(std::size_t i, std::size_t j) {
+            return data_[Layout::index(i, j, cols_)];
+        }
 
         /**
          * @brief Accesses the element at the given row and column (const version).
-         * 
+         *
          * @param i The row index.
          * @param j The column index.
          * @return A const reference to the element at the specified position.
          */
-        const T& operator()(std::size_t i, std::size_t j) const;
+        const T& operator()(std::size_t i, std::size_t j) const {
+            return data_[Layout::index(i, j, cols_)];
+        }
 
         /**
          * @brief Gets the number of rows in the array.
-         * 
+         *
          * @return The number of rows.
          */
-        std::size_t rows() const;
+        std::size_t rows() const {
+            return rows_;
+        }
 
         /**
          * @brief Gets the number of columns in the array.
-         * 
+         *
          * @return The number of columns.
          */
-        std::size_t cols() const;
+        std::size_t cols() const {
+            return cols_;
+        }
 
         /**
          * @brief Exports the data of the array to a vector.
-         * 
+         *
          * @param v The vector to which the data will be exported.
          */
-        void export_data(std::vector<T>& v) const;
+        void export_data(std::vector<T>& v) const {
+            if constexpr (Layout::row_contiguous) {
+                v.assign(data_.begin(), data_.end());
+            } else {
+                // Gather into row-major order, whatever the storage layout
+                v.resize(rows_ * cols_);
+                for (std::size_t i = 0; i < rows_; i++) {
+                    for (std::size_t j = 0; j < cols_; j++) {
+                        v[i * cols_ + j] = (*this)(i, j);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Gets a pointer to the underlying row-major storage.
+         *
+         * Unlike export_data, this does not copy; the pointer stays valid
+         * as long as the array is alive and not resized.
+         *
+         * @return A pointer to the first element.
+         */
+        T* data() {
+            static_assert(Layout::row_contiguous, "data() requires a row-contiguous layout");
+            return data_.data();
+        }
+
+        /**
+         * @brief Gets a pointer to the underlying row-major storage (const version).
+         *
+         * @return A const pointer to the first element.
+         */
+        const T* data() const {
+            static_assert(Layout::row_contiguous, "data() requires a row-contiguous layout");
+            return data_.data();
+        }
+
+        /**
+         * @brief Gets the total number of elements in the array.
+         *
+         * @return rows() * cols().
+         */
+        std::size_t size() const {
+            return rows_ * cols_;
+        }
+
+        /**
+         * @brief Gets a pointer to the start of a row.
+         *
+         * @param i The row index.
+         * @return A pointer to the first element of the row.
+         */
+        T* row(std::size_t i) {
+            static_assert(Layout::row_contiguous, "row() requires a row-contiguous layout");
+            return data_.data() + i * cols_;
+        }
+
+        /**
+         * @brief Gets a pointer to the start of a row (const version).
+         *
+         * @param i The row index.
+         * @return A const pointer to the first element of the row.
+         */
+        const T* row(std::size_t i) const {
+            static_assert(Layout::row_contiguous, "row() requires a row-contiguous layout");
+            return data_.data() + i * cols_;
+        }
+
+        /**
+         * @brief Fills a rectangle with a value.
+         *
+         * The range is half-open: rows r0 to r1 - 1 and columns c0 to
+         * c1 - 1, clamped to the array bounds. Each row is filled as one
+         * contiguous write, which compiles down to memset for byte-sized
+         * elements.
+         *
+         * @param r0 The first row of the rectangle.
+         * @param c0 The first column of the rectangle.
+         * @param r1 One past the last row of the rectangle.
+         * @param c1 One past the last column of the rectangle.
+         * @param value The value to fill with.
+         */
+        void fill_rect(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1, const T& value) {
+            r1 = std::min(r1, rows_);
+            c1 = std::min(c1, cols_);
+            if (r0 >= r1 || c0 >= c1) {
+                return;
+            }
+            if constexpr (Layout::row_contiguous) {
+                for (std::size_t i = r0; i < r1; i++) {
+                    T* first = data_.data() + i * cols_;
+                    std::fill(first + c0, first + c1, value);
+                }
+            } else {
+                for (std::size_t i = r0; i < r1; i++) {
+                    for (std::size_t j = c0; j < c1; j++) {
+                        (*this)(i, j) = value;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Counts the elements equal to a value.
+         *
+         * One linear scan over the contiguous storage, which the compiler
+         * vectorizes for byte-sized elements.
+         *
+         * @param value The value to count.
+         * @return The number of matching elements.
+         */
+        std::size_t count(const T& value) const {
+            if constexpr (Layout::row_contiguous) {
+                return std::count(data_.begin(), data_.end(), value);
+            } else {
+                // The padded storage holds cells outside the array; count
+                // only the real ones
+                std::size_t matches = 0;
+                for (std::size_t i = 0; i < rows_; i++) {
+                    for (std::size_t j = 0; j < cols_; j++) {
+                        matches += ((*this)(i, j) == value) ? 1 : 0;
+                    }
+                }
+                return matches;
+            }
+        }
+
+        /**
+         * @brief Enables dirty-row tracking.
+         *
+         * Once enabled, mark_dirty and mark_all_dirty record which rows
+         * changed and bump the generation counter, so a renderer or diff
+         * layer can re-scan only the touched rows. Tracking is off by
+         * default and costs nothing while disabled.
+         */
+        void enable_dirty_tracking() {
+            if (dirty_rows_.empty()) {
+                dirty_rows_.assign((rows_ + 63) / 64, 0);
+            }
+        }
+
+        /**
+         * @brief Checks whether dirty-row tracking is enabled.
+         *
+         * @return True if tracking is enabled.
+         */
+        bool dirty_tracking_enabled() const {
+            return !dirty_rows_.empty();
+        }
+
+        /**
+         * @brief Records a write to the element at the given position.
+         *
+         * No-op while tracking is disabled. Writes made through data() or
+         * row() pointers are not observed; callers doing bulk writes
+         * should use mark_all_dirty instead.
+         *
+         * @param i The row index of the write.
+         */
+        void mark_dirty(std::size_t i) {
+            if (!dirty_rows_.empty()) {
+                dirty_rows_[i / 64] |= std::uint64_t(1) << (i % 64);
+                generation_++;
+            }
+        }
+
+        /**
+         * @brief Records a write to the given row from a concurrent writer.
+         *
+         * Like mark_dirty, but safe to call from several threads at once:
+         * the bitmap word and the generation counter are updated with
+         * relaxed atomic operations (GCC/Clang builtins, since the fields
+         * are shared with the single-threaded path).
+         *
+         * @param i The row index of the write.
+         */
+        void mark_dirty_atomic(std::size_t i) {
+            if (!dirty_rows_.empty()) {
+                __atomic_fetch_or(&dirty_rows_[i / 64], std::uint64_t(1) << (i % 64), __ATOMIC_RELAXED);
+                __atomic_fetch_add(&generation_, std::uint64_t(1), __ATOMIC_RELAXED);
+            }
+        }
+
+        /**
+         * @brief Records a write to every row.
+         */
+        void mark_all_dirty() {
+            if (!dirty_rows_.empty()) {
+                for (std::uint64_t& word : dirty_rows_) {
+                    word = ~std::uint64_t(0);
+                }
+                generation_++;
+            }
+        }
+
+        /**
+         * @brief Gets the generation counter.
+         *
+         * The counter is bumped by every recorded write, so equal values
+         * mean no change was recorded in between.
+         *
+         * @return The current generation.
+         */
+        std::uint64_t generation() const {
+            return __atomic_load_n(&generation_, __ATOMIC_RELAXED);
+        }
+
+        /**
+         * @brief Fetches the indices of the dirty rows and clears the dirty set.
+         *
+         * Each bitmap word is drained with one atomic exchange, so marks
+         * racing in from concurrent writers (mark_dirty_atomic) land in
+         * either this fetch or the next one, never in neither.
+         *
+         * @param rows_out The vector to which the dirty row indices are appended, in order.
+         */
+        void fetch_dirty_rows(std::vector<std::size_t>& rows_out) {
+            for (std::size_t word_index = 0; word_index < dirty_rows_.size(); word_index++) {
+                std::uint64_t word = __atomic_exchange_n(&dirty_rows_[word_index], std::uint64_t(0), __ATOMIC_ACQUIRE);
+                while (word != 0) {
+                    std::size_t bit = word_index * 64 + lowest_bit(word);
+                    if (bit < rows_) {
+                        rows_out.push_back(bit);
+                    }
+                    word &= word - 1;
+                }
+            }
+        }
 
     private:
+        static std::size_t lowest_bit(std::uint64_t word) {
+            std::size_t bit = 0;
+            while ((word & 1) == 0) {
+                word >>= 1;
+                bit++;
+            }
+            return bit;
+        }
+
         std::size_t rows_; ///< The number of rows in the array.
         std::size_t cols_; ///< The number of columns in the array.
-        std::vector<T> data_; ///< The data storage for the array.
+        std::vector<T, Allocator> data_; ///< The data storage for the array.
+        std::vector<std::uint64_t> dirty_rows_; ///< One bit per row; empty while tracking is disabled.
+        std::uint64_t generation_ = 0; ///< Bumped by every recorded write.
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief A 2D array stored along the Morton curve.
+     *
+     * @tparam T The type of elements stored in the array.
+     */
+    template <typename T>
+    using MortonArray_2D = Array_2D<T, std::allocator<T>, MortonLayout>;
+}
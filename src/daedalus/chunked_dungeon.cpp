@@ -0,0 +1,80 @@
+#include "chunked_dungeon.hpp"
+#include "rng.hpp"
+#include <cstring>
+
+namespace daedalus {
+
+    ChunkedDungeon::ChunkedDungeon(std::size_t rows, std::size_t cols, unsigned long seed,
+                                   DungeonGenerationMethod method, std::size_t max_resident_chunks) :
+    rows_(rows),
+    cols_(cols),
+    seed_(seed),
+    method_(method),
+    max_resident_chunks_(max_resident_chunks > 0 ? max_resident_chunks : 1) {
+    }
+
+    std::uint8_t ChunkedDungeon::operator()(std::size_t i, std::size_t j) {
+        return chunk_at(i, j).tiles(i % CHUNK_SIZE, j % CHUNK_SIZE);
+    }
+
+    void ChunkedDungeon::set_tile(std::size_t i, std::size_t j, std::uint8_t tile) {
+        Chunk& chunk = chunk_at(i, j);
+        chunk.tiles(i % CHUNK_SIZE, j % CHUNK_SIZE) = tile;
+        chunk.dirty = true;
+    }
+
+    bool ChunkedDungeon::is_wall(std::size_t i, std::size_t j) {
+        return (*this)(i, j) == static_cast<std::uint8_t>(DungeonTile::WALL);
+    }
+
+    ChunkedDungeon::Chunk& ChunkedDungeon::chunk_at(std::size_t i, std::size_t j) {
+        std::uint64_t key = (static_cast<std::uint64_t>(i / CHUNK_SIZE) << 32)
+                          | static_cast<std::uint64_t>(j / CHUNK_SIZE);
+        auto found = chunks_.find(key);
+        if (found != chunks_.end()) {
+            lru_.splice(lru_.begin(), lru_, found->second.lru_pos);
+            return found->second;
+        }
+
+        // Derive the chunk seed from the world seed and the chunk
+        // coordinates through the seed hierarchy, so regeneration after
+        // eviction is bit-identical and other nodes agree
+        SeedSequence chunk_seed = WorldSeed(seed_).derive(key);
+
+        RogueDungeon generated(CHUNK_SIZE, CHUNK_SIZE, chunk_seed);
+        generated.generate_random_dungeon(method_);
+
+        Chunk chunk{Array_2D<std::uint8_t>(CHUNK_SIZE, CHUNK_SIZE), false, {}};
+        for (std::size_t row = 0; row < CHUNK_SIZE; row++) {
+            std::memcpy(chunk.tiles.row(row), generated.row(row), CHUNK_SIZE);
+        }
+
+        lru_.push_front(key);
+        chunk.lru_pos = lru_.begin();
+        Chunk& resident = chunks_.emplace(key, std::move(chunk)).first->second;
+        evict();
+        return resident;
+    }
+
+    void ChunkedDungeon::evict() {
+        // Walk from the cold end, skipping dirty chunks: they cannot be
+        // rebuilt from the seed, so they stay for the dungeon's lifetime.
+        // The walk stops short of the front entry - that is the chunk the
+        // caller just touched and holds a reference to, so it is never an
+        // eviction candidate even when dirty chunks exceed the budget
+        auto candidate = lru_.end();
+        while (chunks_.size() > max_resident_chunks_ && candidate != lru_.begin()) {
+            --candidate;
+            if (candidate == lru_.begin()) {
+                break;
+            }
+            auto found = chunks_.find(*candidate);
+            if (found->second.dirty) {
+                continue;
+            }
+            auto dead = candidate++;
+            chunks_.erase(found);
+            lru_.erase(dead);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "array_2D.hpp"
+#include "dungeon.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+/**
+ * @file chunked_dungeon.hpp
+ * @brief A chunked dungeon for maps larger than memory.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class ChunkedDungeon
+     * @brief Dungeon assembled from fixed-size chunks generated on demand.
+     *
+     * Tiles live in 64x64 chunks. A chunk is generated the first time one
+     * of its tiles is touched, from a seed derived deterministically from
+     * the world seed and the chunk coordinates, so the same tile always
+     * has the same value no matter in which order the map is explored.
+     * Each chunk is generated independently; features do not continue
+     * across chunk borders.
+     *
+     * At most a configurable number of chunks stay resident; when the
+     * budget is exceeded the least recently used clean chunk is dropped
+     * (it can be regenerated from its seed at any time). Chunks touched
+     * by set_tile are dirty and never evicted, so explicit edits survive,
+     * and the most recently touched chunk is never evicted either - when
+     * dirty chunks alone fill the budget, residency exceeds it rather
+     * than dropping the chunk in use. Memory therefore scales with the
+     * touched area, not the map bounds.
+     */
+    class ChunkedDungeon {
+        public:
+            static constexpr std::size_t CHUNK_SIZE = 64; /**< Chunk edge length in tiles */
+
+            /**
+             * @brief Constructor for a chunked dungeon of the given total size.
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed World seed every chunk seed is derived from.
+             * @param method Method used to generate each chunk.
+             * @param max_resident_chunks Number of chunks kept in memory.
+             */
+            ChunkedDungeon(std::size_t rows, std::size_t cols, unsigned long seed,
+                           DungeonGenerationMethod method = DungeonGenerationMethod::CELLULAR_AUTOMATA,
+                           std::size_t max_resident_chunks = 64);
+
+            /**
+             * @brief Get the number of rows in the dungeon.
+             * @return Number of rows.
+             */
+            std::size_t rows() const { return rows_; }
+
+            /**
+             * @brief Get the number of columns in the dungeon.
+             * @return Number of columns.
+             */
+            std::size_t cols() const { return cols_; }
+
+            /**
+             * @brief Get the world seed.
+             * @return The seed.
+             */
+            unsigned long seed() const { return seed_; }
+
+            /**
+             * @brief Access a tile, generating its chunk if needed.
+             * @param i Row index.
+             * @param j Column index.
+             * @return The tile value.
+             */
+            std::uint8_t operator()(std::size_t i, std::size_t j);
+
+            /**
+             * @brief Set a tile, generating its chunk if needed.
+             *
+             * The chunk is marked dirty and stays resident until the
+             * dungeon is destroyed.
+             *
+             * @param i Row index.
+             * @param j Column index.
+             * @param tile Tile value to set.
+             */
+            void set_tile(std::size_t i, std::size_t j, std::uint8_t tile);
+
+            /**
+             * @brief Check if a tile at a given position is a wall.
+             * @param i Row index.
+             * @param j Column index.
+             * @return True if the tile is a wall, false otherwise.
+             */
+            bool is_wall(std::size_t i, std::size_t j);
+
+            /**
+             * @brief Get the number of chunks currently in memory.
+             * @return Number of resident chunks.
+             */
+            std::size_t resident_chunks() const { return chunks_.size(); }
+
+        private:
+            /**
+             * @brief One resident chunk.
+             */
+            struct Chunk {
+                Array_2D<std::uint8_t> tiles; /**< The chunk's tiles */
+                bool dirty = false; /**< True once set_tile touched the chunk */
+                std::list<std::uint64_t>::iterator lru_pos; /**< Position in the recency list */
+            };
+
+            /**
+             * @brief Get the chunk holding the given tile, generating or reloading it if needed.
+             * @param i Row index of the tile.
+             * @param j Column index of the tile.
+             * @return Reference to the resident chunk.
+             */
+            Chunk& chunk_at(std::size_t i, std::size_t j);
+
+            /**
+             * @brief Drop least recently used clean chunks until the budget holds.
+             */
+            void evict();
+
+            std::size_t rows_; /**< Number of rows in the dungeon */
+            std::size_t cols_; /**< Number of columns in the dungeon */
+            unsigned long seed_; /**< World seed */
+            DungeonGenerationMethod method_; /**< Method used to generate each chunk */
+            std::size_t max_resident_chunks_; /**< Resident chunk budget */
+            std::unordered_map<std::uint64_t, Chunk> chunks_; /**< Resident chunks by packed chunk coordinates */
+            std::list<std::uint64_t> lru_; /**< Chunk keys, most recently used first */
+    };
+}
@@ -0,0 +1,42 @@
+#include "compressed_dungeon.hpp"
+#include "dungeon.hpp"
+#include <algorithm>
+
+namespace daedalus {
+
+    CompressedDungeon::CompressedDungeon(const Dungeon& dungeon) :
+    rows_(dungeon.rows()),
+    cols_(dungeon.cols()),
+    seed_(dungeon.seed()),
+    entrance_pos_(dungeon.entrance_pos()),
+    exit_pos_(dungeon.exit_pos()) {
+        const Array_2D<std::uint8_t>& tiles = dungeon.tiles_view();
+        const std::uint8_t* data = tiles.data();
+        const std::size_t nb_tiles = tiles.size();
+
+        for (std::size_t pos = 0; pos < nb_tiles;) {
+            std::uint8_t value = data[pos];
+            std::size_t run = 1;
+            while (pos + run < nb_tiles && data[pos + run] == value && run < 0xFFFF) {
+                run++;
+            }
+            runs_.push_back(value);
+            runs_.push_back(static_cast<std::uint8_t>(run & 0xFF));
+            runs_.push_back(static_cast<std::uint8_t>(run >> 8));
+            pos += run;
+        }
+    }
+
+    bool CompressedDungeon::decompress_into(Array_2D<std::uint8_t>& tiles) const {
+        if (tiles.rows() != rows_ || tiles.cols() != cols_) {
+            return false;
+        }
+        std::uint8_t* out = tiles.data();
+        for (std::size_t pos = 0; pos < runs_.size(); pos += 3) {
+            std::size_t run = runs_[pos + 1] | (static_cast<std::size_t>(runs_[pos + 2]) << 8);
+            std::fill(out, out + run, runs_[pos]);
+            out += run;
+        }
+        return true;
+    }
+}
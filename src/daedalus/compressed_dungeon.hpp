@@ -0,0 +1,90 @@
+#pragma once
+
+#include "array_2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file compressed_dungeon.hpp
+ * @brief A run-length compressed dungeon representation for cold storage.
+ */
+
+namespace daedalus {
+
+    class Dungeon;
+
+    /**
+     * @class CompressedDungeon
+     * @brief Run-length encoded snapshot of a dungeon's tiles and metadata.
+     *
+     * Generated maps are mostly long runs of WALL and FLOOR, so idle
+     * sessions can hold one of these instead of a fully materialized
+     * Array_2D; a typical map compresses to a few percent of its raw
+     * size. Dimensions and metadata stay available without decompressing.
+     */
+    class CompressedDungeon {
+        public:
+            /**
+             * @brief Compress the tiles and metadata of a dungeon.
+             * @param dungeon Dungeon to compress.
+             */
+            explicit CompressedDungeon(const Dungeon& dungeon);
+
+            /**
+             * @brief Get the number of rows in the dungeon.
+             * @return Number of rows.
+             */
+            std::size_t rows() const { return rows_; }
+
+            /**
+             * @brief Get the number of columns in the dungeon.
+             * @return Number of columns.
+             */
+            std::size_t cols() const { return cols_; }
+
+            /**
+             * @brief Get the seed the dungeon was generated from.
+             * @return The seed.
+             */
+            unsigned long seed() const { return seed_; }
+
+            /**
+             * @brief Get the entrance tile position.
+             * @return Tuple of (row, column) of the entrance.
+             */
+            std::tuple<std::size_t, std::size_t> entrance_pos() const { return entrance_pos_; }
+
+            /**
+             * @brief Get the exit tile position.
+             * @return Tuple of (row, column) of the exit.
+             */
+            std::tuple<std::size_t, std::size_t> exit_pos() const { return exit_pos_; }
+
+            /**
+             * @brief Get the size of the encoded tile stream.
+             * @return Size in bytes.
+             */
+            std::size_t compressed_size() const { return runs_.size(); }
+
+            /**
+             * @brief Expand the tiles into an existing array.
+             *
+             * Long runs are written with std::fill over the contiguous
+             * storage, so expansion runs at memset speed.
+             *
+             * @param tiles Array to fill; must match the dungeon's dimensions.
+             * @return True if the array was filled, false on a dimension mismatch.
+             */
+            bool decompress_into(Array_2D<std::uint8_t>& tiles) const;
+
+        private:
+            std::size_t rows_; /**< Number of rows in the dungeon */
+            std::size_t cols_; /**< Number of columns in the dungeon */
+            unsigned long seed_; /**< Seed of the compressed dungeon */
+            std::tuple<std::size_t, std::size_t> entrance_pos_; /**< Position of the entrance tile */
+            std::tuple<std::size_t, std::size_t> exit_pos_; /**< Position of the exit tile */
+            std::vector<std::uint8_t> runs_; /**< Encoded stream: tile value followed by a 16-bit little-endian run length */
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "dungeon.hpp"
+
+/**
+ * @file concurrent_tiles.hpp
+ * @brief Lock-free multi-writer access to a dungeon's tiles.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class ConcurrentTileView
+     * @brief Opt-in concurrent mutation mode over a dungeon's tile store.
+     *
+     * Tiles are independent uint8 cells in contiguous storage, so
+     * simulation threads can mutate them with per-cell atomics instead
+     * of a dungeon-wide lock. Memory ordering guarantees: load is
+     * acquire, store is release, and try_set_tile is a strong
+     * compare-exchange with acquire-release ordering - a thread that
+     * loads a value another thread stored also sees everything that
+     * thread wrote before the store. Cells are independent; no ordering
+     * is implied between different tiles.
+     *
+     * Writes mark dirty rows atomically, so a reader draining the dirty
+     * set still gets coherent diffs. They bypass the replication journal
+     * and the connectivity structure, so creating the view invalidates
+     * both; use diff-from-scratch or a rebuildable query after the
+     * concurrent phase. While writers are active, read tiles through
+     * load() rather than the plain query surface.
+     *
+     * The view borrows the dungeon's storage and must not outlive it.
+     */
+    class ConcurrentTileView {
+        public:
+            /**
+             * @brief Constructor for a view over a dungeon's tiles.
+             *
+             * Invalidates the dungeon's replication history and
+             * connectivity cache, which cannot observe concurrent writes.
+             *
+             * @param dungeon Dungeon whose tiles are mutated; must outlive the view.
+             */
+            explicit ConcurrentTileView(Dungeon& dungeon) :
+            tiles_(&dungeon.tiles_) {
+                dungeon.invalidate_replication_history();
+                dungeon.connectivity_valid_ = false;
+            };
+
+            /**
+             * @brief Atomically read a tile.
+             * @param i Row index.
+             * @param j Column index.
+             * @return The tile value, with acquire ordering.
+             */
+            std::uint8_t load(std::size_t i, std::size_t j) const {
+                return __atomic_load_n(cell(i, j), __ATOMIC_ACQUIRE);
+            }
+
+            /**
+             * @brief Atomically write a tile.
+             * @param i Row index.
+             * @param j Column index.
+             * @param tile Tile value to set, with release ordering.
+             */
+            void store(std::size_t i, std::size_t j, std::uint8_t tile) {
+                __atomic_store_n(cell(i, j), tile, __ATOMIC_RELEASE);
+                tiles_->mark_dirty_atomic(i);
+            }
+
+            /**
+             * @brief Atomically set a tile if it still holds the expected value.
+             *
+             * Strong compare-exchange with acquire-release ordering. The
+             * canonical destructible-terrain use: only the thread whose
+             * exchange from WALL succeeds spawns the rubble.
+             *
+             * @param i Row index.
+             * @param j Column index.
+             * @param expected Value the tile must currently hold.
+             * @param desired Value to set.
+             * @return True if this caller performed the exchange.
+             */
+            bool try_set_tile(std::size_t i, std::size_t j, std::uint8_t expected, std::uint8_t desired) {
+                bool exchanged = __atomic_compare_exchange_n(cell(i, j), &expected, desired, false,
+                                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+                if (exchanged) {
+                    tiles_->mark_dirty_atomic(i);
+                }
+                return exchanged;
+            }
+
+        private:
+            /**
+             * @brief Address of a tile cell.
+             * @param i Row index.
+             * @param j Column index.
+             * @return Pointer into the dungeon's storage.
+             */
+            std::uint8_t* cell(std::size_t i, std::size_t j) const {
+                return tiles_->data() + i * tiles_->cols() + j;
+            }
+
+            Array_2D<std::uint8_t>* tiles_; /**< The dungeon's tile storage */
+    };
+}
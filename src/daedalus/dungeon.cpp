@@ -1,31 +1,1090 @@
 #include "dungeon.hpp"
+#include "compressed_dungeon.hpp"
+#include "dungeon_file.hpp"
+#include "generation_kernels.hpp"
+#include "perlin.hpp"
+#include "stats.hpp"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <stdio.h>
 #include <iostream>
 
 namespace daedalus {
 
+    const std::uint8_t& Dungeon::operator()(std::size_t i, std::size_t j) const {
+        return tiles_(i, j);
+    }
+
+    std::size_t Dungeon::rows() const {
+        return tiles_.rows();
+    }
+
+    std::size_t Dungeon::cols() const {
+        return tiles_.cols();
+    }
+
+    void Dungeon::set_tile(std::size_t i, std::size_t j, std::uint8_t tile) {
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        std::uint8_t previous = tiles_(i, j);
+        tiles_(i, j) = tile;
+        tiles_.mark_dirty(i);
+        journal_write(i, j, tile);
+        DAEDALUS_STATS_ADD(tiles_written, 1);
+        if (!connectivity_valid_) {
+            return;
+        }
+        if (tile == wall) {
+            // Union-find cannot split sets; walling over a walkable tile
+            // forces the next connectivity query to rebuild
+            if (previous != wall) {
+                connectivity_valid_ = false;
+            }
+            return;
+        }
+        std::uint32_t cell = static_cast<std::uint32_t>(i * cols() + j);
+        if (i > 0 && tiles_(i - 1, j) != wall) connectivity_.unite(cell, cell - static_cast<std::uint32_t>(cols()));
+        if (i + 1 < rows() && tiles_(i + 1, j) != wall) connectivity_.unite(cell, cell + static_cast<std::uint32_t>(cols()));
+        if (j > 0 && tiles_(i, j - 1) != wall) connectivity_.unite(cell, cell - 1);
+        if (j + 1 < cols() && tiles_(i, j + 1) != wall) connectivity_.unite(cell, cell + 1);
+    }
+
+    void Dungeon::fill_rect(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1, std::uint8_t tile) {
+        tiles_.fill_rect(r0, c0, r1, c1, tile);
+        for (std::size_t i = r0; i < std::min(r1, rows()); i++) {
+            tiles_.mark_dirty(i);
+        }
+        connectivity_valid_ = false;
+        if (r0 < std::min(r1, rows()) && c0 < std::min(c1, cols())) {
+            DAEDALUS_STATS_ADD(tiles_written, (std::min(r1, rows()) - r0) * (std::min(c1, cols()) - c0));
+            if (replication_enabled_) {
+                for (std::size_t i = r0; i < std::min(r1, rows()); i++) {
+                    for (std::size_t j = c0; j < std::min(c1, cols()); j++) {
+                        journal_write(i, j, tile);
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t Dungeon::count_tiles(std::uint8_t tile) const {
+        return tiles_.count(tile);
+    }
+
+    std::size_t Dungeon::flood_fill(std::size_t i, std::size_t j, std::uint8_t tile) {
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        if (i >= nb_rows || j >= nb_cols) {
+            return 0;
+        }
+        std::uint8_t* grid = tiles_.data();
+        const std::uint8_t target = grid[i * nb_cols + j];
+        if (target == tile) {
+            return 0;
+        }
+
+        // Scanline fill: each stack entry is a filled horizontal span whose
+        // vertical neighbors still need scanning
+        struct Span { std::size_t row, left, right; };
+        std::vector<Span> stack;
+        std::size_t filled = 0;
+
+        auto fill_span = [&](std::size_t row, std::size_t col) {
+            std::uint8_t* line = grid + row * nb_cols;
+            if (line[col] != target) {
+                return;
+            }
+            std::size_t left = col;
+            while (left > 0 && line[left - 1] == target) {
+                left--;
+            }
+            std::size_t right = col;
+            while (right + 1 < nb_cols && line[right + 1] == target) {
+                right++;
+            }
+            std::fill(line + left, line + right + 1, tile);
+            tiles_.mark_dirty(row);
+            if (replication_enabled_) {
+                for (std::size_t col = left; col <= right; col++) {
+                    journal_write(row, col, tile);
+                }
+            }
+            filled += right - left + 1;
+            stack.push_back(Span{row, left, right});
+        };
+
+        connectivity_valid_ = false;
+        fill_span(i, j);
+        while (!stack.empty()) {
+            Span span = stack.back();
+            stack.pop_back();
+            for (std::size_t row : {span.row - 1, span.row + 1}) {
+                if (row >= nb_rows) {
+                    continue; // wrapped past the top, or off the bottom
+                }
+                for (std::size_t col = span.left; col <= span.right; col++) {
+                    fill_span(row, col);
+                }
+            }
+        }
+        DAEDALUS_STATS_ADD(tiles_written, filled);
+        return filled;
+    }
+
+    void Dungeon::export_data(std::vector<std::uint8_t>& v) const {
+        tiles_.export_data(v);
+    }
+
+    const Array_2D<std::uint8_t>& Dungeon::tiles_view() const {
+        return tiles_;
+    }
+
+    const std::uint8_t* Dungeon::row(std::size_t i) const {
+        return tiles_.row(i);
+    }
+
+    bool Dungeon::is_wall(std::size_t i, std::size_t j) const {
+        return tiles_(i, j) == static_cast<std::uint8_t>(DungeonTile::WALL);
+    }
+
+    bool Dungeon::is_exit(std::size_t i, std::size_t j) const {
+        return tiles_(i, j) == static_cast<std::uint8_t>(DungeonTile::EXIT);
+    }
+
+    void Dungeon::generate_random_dungeon(DungeonGenerationMethod method){
+        (void)method;
+        std::cerr << "Method not available for this kind of dungeon" << std::endl;
+    }
+
+    void Dungeon::set_entrance(std::size_t i, std::size_t j) {
+        entrance_pos_ = std::make_tuple(i, j);
+        set_tile(i, j, static_cast<std::uint8_t>(DungeonTile::ENTRANCE));
+    }
+
+    void Dungeon::set_exit(std::size_t i, std::size_t j) {
+        exit_pos_ = std::make_tuple(i, j);
+        set_tile(i, j, static_cast<std::uint8_t>(DungeonTile::EXIT));
+    }
+
+    void Dungeon::enable_dirty_tracking() {
+        tiles_.enable_dirty_tracking();
+    }
+
+    void Dungeon::journal_write(std::size_t i, std::size_t j, std::uint8_t tile) {
+        if (replication_enabled_) {
+            journal_.push_back(TileWrite{static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j), tile});
+        }
+    }
+
+    void Dungeon::invalidate_replication_history() {
+        if (replication_enabled_) {
+            journal_base_ += journal_.size() + 1;
+            journal_.clear();
+        }
+    }
+
+    void Dungeon::enable_replication() {
+        replication_enabled_ = true;
+    }
+
+    std::uint64_t Dungeon::snapshot() const {
+        return journal_base_ + journal_.size();
+    }
+
+    namespace {
+        void put_u64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+            for (int b = 0; b < 8; b++) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * b)));
+            }
+        }
+
+        void put_u32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            for (int b = 0; b < 4; b++) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * b)));
+            }
+        }
+
+        std::uint64_t get_u64(const std::uint8_t* p) {
+            std::uint64_t value = 0;
+            for (int b = 0; b < 8; b++) {
+                value |= static_cast<std::uint64_t>(p[b]) << (8 * b);
+            }
+            return value;
+        }
+
+        std::uint32_t get_u32(const std::uint8_t* p) {
+            std::uint32_t value = 0;
+            for (int b = 0; b < 4; b++) {
+                value |= static_cast<std::uint32_t>(p[b]) << (8 * b);
+            }
+            return value;
+        }
+
+        constexpr std::size_t PATCH_HEADER_SIZE = 24; ///< from, to, count as u64.
+        constexpr std::size_t PATCH_ENTRY_SIZE = 9; ///< row u32, column u32, value u8.
+    }
+
+    bool Dungeon::diff(std::uint64_t since_version, std::vector<std::uint8_t>& out) const {
+        std::uint64_t to_version = snapshot();
+        if (since_version < journal_base_ || since_version > to_version) {
+            return false; // history trimmed or version from elsewhere
+        }
+        std::uint64_t count = to_version - since_version;
+        put_u64(out, since_version);
+        put_u64(out, to_version);
+        put_u64(out, count);
+        for (std::size_t k = since_version - journal_base_; k < journal_.size(); k++) {
+            put_u32(out, journal_[k].i);
+            put_u32(out, journal_[k].j);
+            out.push_back(journal_[k].value);
+        }
+        return true;
+    }
+
+    bool Dungeon::apply_patch(const std::vector<std::uint8_t>& patch) {
+        if (patch.size() < PATCH_HEADER_SIZE) {
+            return false;
+        }
+        std::uint64_t count = get_u64(patch.data() + 16);
+        // The division form avoids overflowing count * entry size on a
+        // crafted header
+        if (count != (patch.size() - PATCH_HEADER_SIZE) / PATCH_ENTRY_SIZE
+            || patch.size() != PATCH_HEADER_SIZE + count * PATCH_ENTRY_SIZE) {
+            return false;
+        }
+        // Validate every entry before touching a tile, so a malformed
+        // patch cannot leave the dungeon half applied
+        const std::uint8_t* entry = patch.data() + PATCH_HEADER_SIZE;
+        for (std::uint64_t k = 0; k < count; k++) {
+            if (get_u32(entry + k * PATCH_ENTRY_SIZE) >= rows()
+                || get_u32(entry + k * PATCH_ENTRY_SIZE + 4) >= cols()) {
+                return false;
+            }
+        }
+        for (std::uint64_t k = 0; k < count; k++, entry += PATCH_ENTRY_SIZE) {
+            set_tile(get_u32(entry), get_u32(entry + 4), entry[8]);
+        }
+        return true;
+    }
+
+    void Dungeon::discard_history(std::uint64_t before_version) {
+        if (before_version <= journal_base_) {
+            return;
+        }
+        std::uint64_t keep_from = std::min<std::uint64_t>(before_version - journal_base_, journal_.size());
+        journal_.erase(journal_.begin(), journal_.begin() + static_cast<std::ptrdiff_t>(keep_from));
+        journal_base_ += keep_from;
+    }
+
+    std::uint64_t Dungeon::tile_generation() const {
+        return tiles_.generation();
+    }
+
+    void Dungeon::fetch_dirty_rows(std::vector<std::size_t>& rows_out) {
+        tiles_.fetch_dirty_rows(rows_out);
+    }
+
+    unsigned long Dungeon::seed() const {
+        return seed_;
+    }
+
+    std::tuple<std::size_t, std::size_t> Dungeon::entrance_pos() const {
+        return entrance_pos_;
+    }
+
+    std::tuple<std::size_t, std::size_t> Dungeon::exit_pos() const {
+        return exit_pos_;
+    }
+
+    DungeonGenerationMethod Dungeon::generation_method() const {
+        return method_;
+    }
+
+    CompressedDungeon Dungeon::compress() const {
+        return CompressedDungeon(*this);
+    }
+
+    Dungeon::Dungeon(const CompressedDungeon& compressed) :
+    Dungeon(compressed.rows(), compressed.cols(), compressed.seed()) {
+        compressed.decompress_into(tiles_);
+        entrance_pos_ = compressed.entrance_pos();
+        exit_pos_ = compressed.exit_pos();
+    }
+
+    bool Dungeon::save(const std::string& path) const {
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            std::cerr << "Could not open " << path << " for writing" << std::endl;
+            return false;
+        }
+        DungeonFileHeader header;
+        header.magic = DungeonFileHeader::MAGIC;
+        header.rows = rows();
+        header.cols = cols();
+        header.seed = seed_;
+        header.entrance_i = std::get<0>(entrance_pos_);
+        header.entrance_j = std::get<1>(entrance_pos_);
+        header.exit_i = std::get<0>(exit_pos_);
+        header.exit_j = std::get<1>(exit_pos_);
+        header.method = static_cast<std::uint64_t>(method_);
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+        if (ok && tiles_.size() > 0) {
+            ok = fwrite(tiles_.data(), 1, tiles_.size(), file) == tiles_.size();
+        }
+        if (fclose(file) != 0) {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Could not write dungeon file " << path << std::endl;
+        }
+        return ok;
+    }
+
+    Dungeon Dungeon::load(const std::string& path) {
+        MappedDungeon mapped(path);
+        if (!mapped.valid()) {
+            return Dungeon(0, 0, 0);
+        }
+        Dungeon dungeon(mapped.rows(), mapped.cols(), mapped.seed());
+        if (dungeon.tiles_.size() > 0) {
+            std::memcpy(dungeon.tiles_.data(), mapped.data(), dungeon.tiles_.size());
+        }
+        dungeon.entrance_pos_ = mapped.entrance_pos();
+        dungeon.exit_pos_ = mapped.exit_pos();
+        dungeon.method_ = static_cast<DungeonGenerationMethod>(mapped.generation_method());
+        return dungeon;
+    }
+
+    bool Dungeon::find_path(std::tuple<std::size_t, std::size_t> from,
+                            std::tuple<std::size_t, std::size_t> to,
+                            PathfindingContext& ctx) const {
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        const std::size_t si = std::get<0>(from);
+        const std::size_t sj = std::get<1>(from);
+        const std::size_t ti = std::get<0>(to);
+        const std::size_t tj = std::get<1>(to);
+        if (si >= nb_rows || sj >= nb_cols || ti >= nb_rows || tj >= nb_cols) {
+            return false;
+        }
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        const std::uint8_t* grid = tiles_.data();
+        const std::uint32_t start = static_cast<std::uint32_t>(si * nb_cols + sj);
+        const std::uint32_t goal = static_cast<std::uint32_t>(ti * nb_cols + tj);
+        if (grid[start] == wall || grid[goal] == wall) {
+            return false;
+        }
+
+        // Manhattan distance to the goal; admissible for unit-cost
+        // 4-connected movement
+        auto heuristic = [ti, tj, nb_cols](std::uint32_t cell) {
+            std::size_t i = cell / nb_cols;
+            std::size_t j = cell % nb_cols;
+            return static_cast<std::uint32_t>((i > ti ? i - ti : ti - i) + (j > tj ? j - tj : tj - j));
+        };
+
+        ctx.prepare(nb_rows * nb_cols);
+        ctx.dist_[start] = 0;
+        ctx.parent_[start] = start;
+        ctx.stamp_of_[start] = ctx.stamp_;
+        std::uint32_t start_f = heuristic(start);
+        if (ctx.buckets_.size() <= start_f) {
+            ctx.buckets_.resize(start_f + 1);
+        }
+        ctx.buckets_[start_f].push_back(start);
+
+        bool found = false;
+        for (std::uint32_t f = start_f; f < ctx.buckets_.size() && !found; f++) {
+            // Index on every pass: pushing neighbors can grow buckets_ and
+            // would invalidate a held reference
+            while (!ctx.buckets_[f].empty() && !found) {
+                std::uint32_t cell = ctx.buckets_[f].back();
+                ctx.buckets_[f].pop_back();
+                std::uint32_t g = ctx.dist_[cell];
+                if (g + heuristic(cell) != f) {
+                    continue; // stale entry, a shorter route was found after the push
+                }
+                if (cell == goal) {
+                    found = true;
+                    break;
+                }
+                ctx.expanded_++;
+
+                std::uint32_t neighbors[4];
+                std::size_t nb_neighbors = 0;
+                std::size_t i = cell / nb_cols;
+                std::size_t j = cell % nb_cols;
+                if (i > 0) neighbors[nb_neighbors++] = cell - static_cast<std::uint32_t>(nb_cols);
+                if (i + 1 < nb_rows) neighbors[nb_neighbors++] = cell + static_cast<std::uint32_t>(nb_cols);
+                if (j > 0) neighbors[nb_neighbors++] = cell - 1;
+                if (j + 1 < nb_cols) neighbors[nb_neighbors++] = cell + 1;
+
+                for (std::size_t n = 0; n < nb_neighbors; n++) {
+                    std::uint32_t next = neighbors[n];
+                    if (grid[next] == wall) {
+                        continue;
+                    }
+                    std::uint32_t ng = g + 1;
+                    if (ctx.stamp_of_[next] == ctx.stamp_ && ctx.dist_[next] <= ng) {
+                        continue;
+                    }
+                    ctx.dist_[next] = ng;
+                    ctx.parent_[next] = cell;
+                    ctx.stamp_of_[next] = ctx.stamp_;
+                    std::uint32_t nf = ng + heuristic(next);
+                    if (ctx.buckets_.size() <= nf) {
+                        ctx.buckets_.resize(nf + 1);
+                    }
+                    ctx.buckets_[nf].push_back(next);
+                }
+            }
+        }
+
+        DAEDALUS_STATS_ADD(pathfinding_queries, 1);
+        DAEDALUS_STATS_ADD(pathfinding_expansions, ctx.expanded_);
+        if (!found) {
+            return false;
+        }
+        for (std::uint32_t cell = goal;; cell = ctx.parent_[cell]) {
+            ctx.path_.push_back(std::make_tuple(cell / nb_cols, cell % nb_cols));
+            if (cell == start) {
+                break;
+            }
+        }
+        std::reverse(ctx.path_.begin(), ctx.path_.end());
+        return true;
+    }
+
+    void Dungeon::rebuild_connectivity() {
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        const std::uint8_t* grid = tiles_.data();
+        connectivity_.reset(nb_rows * nb_cols);
+        for (std::size_t i = 0; i < nb_rows; i++) {
+            for (std::size_t j = 0; j < nb_cols; j++) {
+                std::uint32_t cell = static_cast<std::uint32_t>(i * nb_cols + j);
+                if (grid[cell] == wall) {
+                    continue;
+                }
+                if (i + 1 < nb_rows && grid[cell + nb_cols] != wall) {
+                    connectivity_.unite(cell, cell + static_cast<std::uint32_t>(nb_cols));
+                }
+                if (j + 1 < nb_cols && grid[cell + 1] != wall) {
+                    connectivity_.unite(cell, cell + 1);
+                }
+            }
+        }
+        connectivity_valid_ = true;
+    }
+
+    bool Dungeon::validate_connectivity() {
+        return connected(entrance_pos_, exit_pos_);
+    }
+
+    bool Dungeon::connected(std::tuple<std::size_t, std::size_t> a, std::tuple<std::size_t, std::size_t> b) {
+        const std::size_t ai = std::get<0>(a);
+        const std::size_t aj = std::get<1>(a);
+        const std::size_t bi = std::get<0>(b);
+        const std::size_t bj = std::get<1>(b);
+        if (ai >= rows() || aj >= cols() || bi >= rows() || bj >= cols()) {
+            return false;
+        }
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        if (tiles_(ai, aj) == wall || tiles_(bi, bj) == wall) {
+            return false;
+        }
+        if (!connectivity_valid_) {
+            rebuild_connectivity();
+        }
+        return connectivity_.connected(static_cast<std::uint32_t>(ai * cols() + aj),
+                                       static_cast<std::uint32_t>(bi * cols() + bj));
+    }
+
+    FlowField Dungeon::compute_flow_field(std::tuple<std::size_t, std::size_t> goal) const {
+        return compute_flow_field(std::vector<std::tuple<std::size_t, std::size_t>>{goal});
+    }
+
+    FlowField Dungeon::compute_flow_field(const std::vector<std::tuple<std::size_t, std::size_t>>& goals) const {
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        const std::uint8_t* grid = tiles_.data();
+
+        FlowField field(nb_rows, nb_cols);
+        std::uint16_t* dist = field.distance.data();
+        std::uint8_t* dir = field.direction.data();
+        std::fill(dist, dist + field.distance.size(), FlowField::UNREACHABLE);
+        std::fill(dir, dir + field.direction.size(), static_cast<std::uint8_t>(FlowDirection::NONE));
+
+        // Multi-source BFS outward from the goals; each visited tile records
+        // the step back toward the tile it was discovered from
+        std::vector<std::uint32_t> queue;
+        queue.reserve(nb_rows * nb_cols);
+        for (const std::tuple<std::size_t, std::size_t>& goal : goals) {
+            std::size_t i = std::get<0>(goal);
+            std::size_t j = std::get<1>(goal);
+            if (i >= nb_rows || j >= nb_cols || grid[i * nb_cols + j] == wall) {
+                continue;
+            }
+            std::uint32_t cell = static_cast<std::uint32_t>(i * nb_cols + j);
+            if (dist[cell] != 0) {
+                dist[cell] = 0;
+                queue.push_back(cell);
+            }
+        }
+
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            std::uint32_t cell = queue[head];
+            std::uint16_t next_dist = static_cast<std::uint16_t>(std::min<std::uint32_t>(dist[cell] + 1, FlowField::UNREACHABLE - 1));
+            std::size_t i = cell / nb_cols;
+            std::size_t j = cell % nb_cols;
+
+            // Each entry pairs a neighbor with the direction from that
+            // neighbor back to this cell
+            struct { std::uint32_t cell; FlowDirection dir; } neighbors[4];
+            std::size_t nb_neighbors = 0;
+            if (i > 0) neighbors[nb_neighbors++] = {cell - static_cast<std::uint32_t>(nb_cols), FlowDirection::DOWN};
+            if (i + 1 < nb_rows) neighbors[nb_neighbors++] = {cell + static_cast<std::uint32_t>(nb_cols), FlowDirection::UP};
+            if (j > 0) neighbors[nb_neighbors++] = {cell - 1, FlowDirection::RIGHT};
+            if (j + 1 < nb_cols) neighbors[nb_neighbors++] = {cell + 1, FlowDirection::LEFT};
+
+            for (std::size_t n = 0; n < nb_neighbors; n++) {
+                std::uint32_t next = neighbors[n].cell;
+                if (grid[next] == wall || dist[next] != FlowField::UNREACHABLE) {
+                    continue;
+                }
+                dist[next] = next_dist;
+                dir[next] = static_cast<std::uint8_t>(neighbors[n].dir);
+                queue.push_back(next);
+            }
+        }
+        return field;
+    }
+
+    namespace {
+        /// Walker moves consumed by one drunken walk generation step.
+        constexpr std::size_t DRUNKEN_WALK_MOVES_PER_STEP = 4096;
+    }
+
+    namespace {
+        /**
+         * @brief Per-thread result of the last find_path_djikstra call.
+         *
+         * Keeping the hot path out of the Dungeon itself is what makes the
+         * query surface const and lock-free to share across threads.
+         */
+        struct HotPathResult {
+            const Dungeon* owner = nullptr; ///< Dungeon the path belongs to.
+            std::vector<std::tuple<std::size_t, std::size_t>> path; ///< The path found.
+        };
+
+        thread_local PathfindingContext djikstra_ctx;
+        thread_local HotPathResult hot_path_result;
+    }
+
+    bool Dungeon::find_path_djikstra() const {
+        bool found = find_path(entrance_pos_, exit_pos_, djikstra_ctx);
+        hot_path_result.owner = this;
+        hot_path_result.path = found ? djikstra_ctx.path() : std::vector<std::tuple<std::size_t, std::size_t>>();
+        return found;
+    }
+
+    std::vector<std::tuple<std::size_t, std::size_t>> Dungeon::get_hot_path_djikstra() const {
+        if (hot_path_result.owner != this) {
+            return {};
+        }
+        return hot_path_result.path;
+    }
+
+    RogueDungeon::RogueDungeon(std::size_t rows, std::size_t cols, unsigned long seed) :
+    Dungeon(rows, cols, seed) {
+    }
+
+    bool RogueDungeon::place_room(std::tuple<std::size_t, std::size_t> from, std::tuple<std::size_t, std::size_t> to){
+        std::size_t r0 = std::get<0>(from);
+        std::size_t c0 = std::get<1>(from);
+        std::size_t r1 = std::get<0>(to);
+        std::size_t c1 = std::get<1>(to);
+        if (r0 > r1 || c0 > c1 || r1 >= rows() || c1 >= cols()) {
+            return false;
+        }
+        fill_rect(r0, c0, r1 + 1, c1 + 1, static_cast<std::uint8_t>(DungeonTile::FLOOR));
+        region_index_.add_rect_region(r0, c0, r1 + 1, c1 + 1);
+        return true;
+    }
+
+    RogueDungeon RogueDungeon::generate(std::size_t rows, std::size_t cols, unsigned long seed,
+                                        DungeonGenerationMethod method){
+        RogueDungeon dungeon(rows, cols, seed);
+        dungeon.generate_random_dungeon(method);
+        return dungeon;
+    }
+
     void RogueDungeon::generate_random_dungeon(DungeonGenerationMethod method){
+        DAEDALUS_STATS_GENERATION_TIMER(method);
+        begin_step_generation(method);
+        while (advance_step_generation()) {
+        }
+        end_step_generation();
+    }
+
+    void RogueDungeon::begin_step_generation(DungeonGenerationMethod method){
 
+        set_generation_method(method);
+        generation_steps_remaining_ = 0;
+        region_index_.clear(rows(), cols());
         switch (method) {
             case DungeonGenerationMethod::NAIVE :
-                // Implement the naive dungeon generation algorithm here
-                // Example: Just fill the dungeon with random rooms and corridors
-                
-                // Your naive dungeon generation logic
+                // Fill the dungeon with walls; the steps carve random rooms
+                // and corridors
+                fill_rect(0, 0, rows(), cols(), static_cast<std::uint8_t>(DungeonTile::WALL));
+                has_room_ = false;
+                generation_steps_remaining_ = std::max<std::size_t>(4, (rows() * cols()) / 256);
                 break;
+            case DungeonGenerationMethod::CELLULAR_AUTOMATA: {
+                // Random noise fill; the steps are smoothing passes over it
+                std::uniform_int_distribution<int> noise_dist(0, 99);
+                for (std::size_t i = 0; i < rows(); i++) {
+                    for (std::size_t j = 0; j < cols(); j++) {
+                        bool wall = (i == 0 || j == 0 || i == rows() - 1 || j == cols() - 1 || noise_dist(rng()) < 45);
+                        set_tile(i, j, static_cast<std::uint8_t>(wall ? DungeonTile::WALL : DungeonTile::FLOOR));
+                    }
+                }
+                generation_steps_remaining_ = 5;
+                break;
+            }
             case DungeonGenerationMethod::BSP:
+                // Partition the map; the steps carve one room per leaf,
+                // chaining consecutive leaves with corridors
+                fill_rect(0, 0, rows(), cols(), static_cast<std::uint8_t>(DungeonTile::WALL));
+                has_room_ = false;
+                build_bsp_tree();
+                for (const BspNode& node : bsp_nodes_) {
+                    if (node.first_child == -1) {
+                        generation_steps_remaining_++;
+                    }
+                }
+                break;
             case DungeonGenerationMethod::DRUNKEN_WALK:
-            case DungeonGenerationMethod::CELLULAR_AUTOMATA:
+                // Fill the dungeon with walls; the steps let a walker carve
+                // floor from the center outward
+                fill_rect(0, 0, rows(), cols(), static_cast<std::uint8_t>(DungeonTile::WALL));
+                drunk_i_ = rows() / 2;
+                drunk_j_ = cols() / 2;
+                if (rows() >= 3 && cols() >= 3) {
+                    // Roughly four moves per map cell carves expansive caves
+                    generation_steps_remaining_ = (rows() * cols() * 4) / DRUNKEN_WALK_MOVES_PER_STEP + 1;
+                }
+                break;
             case DungeonGenerationMethod::VORONOI:
+                // The whole partition is computed in one advance call; the
+                // jump-flood passes are not meaningful frames on their own
+                generation_steps_remaining_ = 1;
+                break;
             case DungeonGenerationMethod::PERLIN_NOISE:
-                std::cerr << "Method not implemented yet" << std::endl;
+                // Evaluated in one advance call, row-at-a-time
+                generation_steps_remaining_ = 1;
                 break;
             default:
                 std::cerr << "Method not available for this kind of dungeon" << std::endl;
             }
     }
 
+    bool RogueDungeon::advance_step_generation(){
+        if (generation_steps_remaining_ == 0) {
+            return false;
+        }
+        switch (generation_method()) {
+            case DungeonGenerationMethod::NAIVE :
+                generate_random_dungeon_naive_step();
+                break;
+            case DungeonGenerationMethod::CELLULAR_AUTOMATA:
+                generate_random_dungeon_cellular_automata_step();
+                break;
+            case DungeonGenerationMethod::BSP:
+                generate_random_dungeon_bsp_step();
+                break;
+            case DungeonGenerationMethod::DRUNKEN_WALK:
+                generate_random_dungeon_drunken_walk_step();
+                break;
+            case DungeonGenerationMethod::VORONOI:
+                generate_voronoi();
+                break;
+            case DungeonGenerationMethod::PERLIN_NOISE:
+                generate_perlin();
+                break;
+            default:
+                break;
+        }
+        generation_steps_remaining_--;
+        return true;
+    }
 
+    void RogueDungeon::end_step_generation(){
+        switch (generation_method()) {
+            case DungeonGenerationMethod::NAIVE :
+            case DungeonGenerationMethod::BSP:
+                if (has_room_) {
+                    set_entrance(std::get<0>(first_room_center_), std::get<1>(first_room_center_));
+                    set_exit(std::get<0>(last_room_center_), std::get<1>(last_room_center_));
+                }
+                break;
+            case DungeonGenerationMethod::CELLULAR_AUTOMATA:
+            case DungeonGenerationMethod::DRUNKEN_WALK:
+            case DungeonGenerationMethod::VORONOI:
+            case DungeonGenerationMethod::PERLIN_NOISE:
+                place_entrance_and_exit_on_floor();
+                // These areas emerge from noise rather than explicit
+                // carving; label them in one sweep while the map is hot
+                region_index_.rebuild(tiles(), static_cast<std::uint8_t>(DungeonTile::WALL));
+                break;
+            default:
+                break;
+        }
+        // Generation steps write whole rows through raw pointers, so the
+        // per-write tracking does not see them; replication history is
+        // likewise no longer diffable
+        tiles().mark_all_dirty();
+        invalidate_replication_history();
+    }
+
+    void RogueDungeon::place_entrance_and_exit_on_floor(){
+        const std::uint8_t floor = static_cast<std::uint8_t>(DungeonTile::FLOOR);
+        bool entrance_placed = false;
+        for (std::size_t i = 0; i < rows(); i++) {
+            for (std::size_t j = 0; j < cols(); j++) {
+                if ((*this)(i, j) == floor) {
+                    set_entrance(i, j);
+                    entrance_placed = true;
+                    break;
+                }
+            }
+            if (entrance_placed) {
+                break;
+            }
+        }
+        if (!entrance_placed) {
+            return;
+        }
+        for (std::size_t i = rows(); i-- > 0;) {
+            for (std::size_t j = cols(); j-- > 0;) {
+                if ((*this)(i, j) == floor) {
+                    set_exit(i, j);
+                    return;
+                }
+            }
+        }
+    }
+
+    void RogueDungeon::generate_random_dungeon_naive_step(){
+        if (rows() < 5 || cols() < 5) {
+            return;
+        }
+
+        // Pick a room that fits inside the outer wall border
+        std::uniform_int_distribution<std::size_t> height_dist(3, std::max<std::size_t>(3, rows() / 4));
+        std::uniform_int_distribution<std::size_t> width_dist(3, std::max<std::size_t>(3, cols() / 4));
+        std::size_t height = std::min(height_dist(rng()), rows() - 2);
+        std::size_t width = std::min(width_dist(rng()), cols() - 2);
+
+        std::uniform_int_distribution<std::size_t> row_dist(1, rows() - 1 - height);
+        std::uniform_int_distribution<std::size_t> col_dist(1, cols() - 1 - width);
+        std::size_t top = row_dist(rng());
+        std::size_t left = col_dist(rng());
+
+        fill_rect(top, left, top + height, left + width, static_cast<std::uint8_t>(DungeonTile::FLOOR));
+        region_index_.add_rect_region(top, left, top + height, left + width);
+
+        std::tuple<std::size_t, std::size_t> center = std::make_tuple(top + height / 2, left + width / 2);
+
+        if (has_room_) {
+            carve_corridor(last_room_center_, center);
+        } else {
+            first_room_center_ = center;
+            has_room_ = true;
+        }
+        last_room_center_ = center;
+    }
+
+    void RogueDungeon::build_bsp_tree(){
+        // Regions smaller than this are not split further; large enough for
+        // a 3x3 room plus a one-tile margin on each side
+        const std::uint32_t min_leaf = 6;
+        bsp_nodes_.clear();
+        bsp_next_leaf_ = 0;
+        if (rows() < min_leaf + 2 || cols() < min_leaf + 2) {
+            return;
+        }
+        bsp_nodes_.push_back(BspNode{1, 1,
+                                     static_cast<std::uint32_t>(rows() - 2),
+                                     static_cast<std::uint32_t>(cols() - 2),
+                                     -1, 0, 0});
+
+        // Children are appended behind their parent, so one forward scan
+        // over the growing pool visits every node exactly once
+        for (std::size_t n = 0; n < bsp_nodes_.size(); n++) {
+            // Copy the bounds: pushing children may reallocate the pool
+            BspNode node = bsp_nodes_[n];
+            bool can_split_h = node.height >= 2 * min_leaf;
+            bool can_split_v = node.width >= 2 * min_leaf;
+            if (!can_split_h && !can_split_v) {
+                continue;
+            }
+            // Split across the longer dimension to keep regions squarish
+            bool horizontal = can_split_h && (!can_split_v || node.height >= node.width);
+            bsp_nodes_[n].first_child = static_cast<std::int32_t>(bsp_nodes_.size());
+            if (horizontal) {
+                std::uniform_int_distribution<std::uint32_t> split_dist(min_leaf, node.height - min_leaf);
+                std::uint32_t split = split_dist(rng());
+                bsp_nodes_.push_back(BspNode{node.top, node.left, split, node.width, -1, 0, 0});
+                bsp_nodes_.push_back(BspNode{node.top + split, node.left, node.height - split, node.width, -1, 0, 0});
+            } else {
+                std::uniform_int_distribution<std::uint32_t> split_dist(min_leaf, node.width - min_leaf);
+                std::uint32_t split = split_dist(rng());
+                bsp_nodes_.push_back(BspNode{node.top, node.left, node.height, split, -1, 0, 0});
+                bsp_nodes_.push_back(BspNode{node.top, node.left + split, node.height, node.width - split, -1, 0, 0});
+            }
+        }
+    }
+
+    void RogueDungeon::generate_random_dungeon_bsp_step(){
+        if (bsp_nodes_.empty()) {
+            build_bsp_tree();
+            return;
+        }
+
+        // Carve the room of the next leaf in pool order and chain it to the
+        // previously carved one
+        while (bsp_next_leaf_ < bsp_nodes_.size() && bsp_nodes_[bsp_next_leaf_].first_child != -1) {
+            bsp_next_leaf_++;
+        }
+        if (bsp_next_leaf_ >= bsp_nodes_.size()) {
+            return;
+        }
+        BspNode& leaf = bsp_nodes_[bsp_next_leaf_];
+        bsp_next_leaf_++;
+
+        std::uniform_int_distribution<std::uint32_t> height_dist(3, leaf.height - 2);
+        std::uniform_int_distribution<std::uint32_t> width_dist(3, leaf.width - 2);
+        std::uint32_t height = height_dist(rng());
+        std::uint32_t width = width_dist(rng());
+        std::uniform_int_distribution<std::uint32_t> row_dist(leaf.top + 1, leaf.top + leaf.height - 1 - height);
+        std::uniform_int_distribution<std::uint32_t> col_dist(leaf.left + 1, leaf.left + leaf.width - 1 - width);
+        std::uint32_t top = row_dist(rng());
+        std::uint32_t left = col_dist(rng());
+
+        fill_rect(top, left, top + height, left + width, static_cast<std::uint8_t>(DungeonTile::FLOOR));
+        region_index_.add_rect_region(top, left, top + height, left + width);
+        leaf.room_center_i = top + height / 2;
+        leaf.room_center_j = left + width / 2;
+        std::tuple<std::size_t, std::size_t> center = std::make_tuple(leaf.room_center_i, leaf.room_center_j);
+
+        if (has_room_) {
+            carve_corridor(last_room_center_, center);
+        } else {
+            first_room_center_ = center;
+            has_room_ = true;
+        }
+        last_room_center_ = center;
+    }
+
+    void RogueDungeon::carve_corridor(std::tuple<std::size_t, std::size_t> from, std::tuple<std::size_t, std::size_t> to){
+        const std::uint8_t floor = static_cast<std::uint8_t>(DungeonTile::FLOOR);
+        std::size_t i = std::get<0>(from);
+        std::size_t j = std::get<1>(from);
+        const std::size_t ti = std::get<0>(to);
+        const std::size_t tj = std::get<1>(to);
+
+        // Carve horizontally then vertically; a transition between indexed
+        // and unindexed tiles is a door of the room being left or entered
+        std::uint32_t prev_region = region_index_.region_at(i, j);
+        std::size_t prev_i = i;
+        std::size_t prev_j = j;
+        auto visit = [&](std::size_t vi, std::size_t vj) {
+            std::uint32_t region = region_index_.region_at(vi, vj);
+            if (region == RegionIndex::NO_REGION) {
+                set_tile(vi, vj, floor);
+                if (prev_region != RegionIndex::NO_REGION) {
+                    region_index_.add_door(prev_region, vi, vj);
+                }
+            } else if (prev_region == RegionIndex::NO_REGION) {
+                region_index_.add_door(region, prev_i, prev_j);
+            }
+            prev_region = region;
+            prev_i = vi;
+            prev_j = vj;
+        };
+        while (j != tj) {
+            visit(i, j);
+            j += (j < tj) ? 1 : -1;
+        }
+        while (i != ti) {
+            visit(i, j);
+            i += (i < ti) ? 1 : -1;
+        }
+    }
+
+    void RogueDungeon::generate_random_dungeon_drunken_walk_step(){
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        if (nb_rows < 3 || nb_cols < 3) {
+            return;
+        }
+        const std::uint8_t floor = static_cast<std::uint8_t>(DungeonTile::FLOOR);
+        std::uint8_t* grid = tiles().data();
+
+        // The hot loop is one direction draw and one tile write per move:
+        // random bits are pulled 32 at a time (16 two-bit directions per
+        // draw, valid for any generator policy), the coordinate update is
+        // a table lookup, and the border clamp compiles to min/max moves
+        // instead of branches
+        static const std::ptrdiff_t di[4] = {-1, 1, 0, 0};
+        static const std::ptrdiff_t dj[4] = {0, 0, -1, 1};
+        std::ptrdiff_t i = static_cast<std::ptrdiff_t>(drunk_i_);
+        std::ptrdiff_t j = static_cast<std::ptrdiff_t>(drunk_j_);
+        const std::ptrdiff_t max_i = static_cast<std::ptrdiff_t>(nb_rows) - 2;
+        const std::ptrdiff_t max_j = static_cast<std::ptrdiff_t>(nb_cols) - 2;
+
+        for (std::size_t move = 0; move < DRUNKEN_WALK_MOVES_PER_STEP; move += 16) {
+            std::uint32_t draws = static_cast<std::uint32_t>(rng()());
+            for (int b = 0; b < 32; b += 2) {
+                unsigned dir = (draws >> b) & 3;
+                i = std::min(std::max(i + di[dir], std::ptrdiff_t(1)), max_i);
+                j = std::min(std::max(j + dj[dir], std::ptrdiff_t(1)), max_j);
+                grid[i * static_cast<std::ptrdiff_t>(nb_cols) + j] = floor;
+            }
+        }
+        drunk_i_ = static_cast<std::size_t>(i);
+        drunk_j_ = static_cast<std::size_t>(j);
+    }
+
+    void RogueDungeon::generate_voronoi(){
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        if (nb_rows < 3 || nb_cols < 3) {
+            return;
+        }
+        constexpr std::uint32_t NO_OWNER = 0xFFFFFFFFu;
+
+        // Scatter the cell seeds
+        std::size_t nb_seeds = std::max<std::size_t>(4, (nb_rows * nb_cols) / 512);
+        std::vector<std::uint32_t> seed_i(nb_seeds);
+        std::vector<std::uint32_t> seed_j(nb_seeds);
+        std::uniform_int_distribution<std::uint32_t> row_dist(0, static_cast<std::uint32_t>(nb_rows - 1));
+        std::uniform_int_distribution<std::uint32_t> col_dist(0, static_cast<std::uint32_t>(nb_cols - 1));
+        std::vector<std::uint32_t> owner(nb_rows * nb_cols, NO_OWNER);
+        for (std::size_t s = 0; s < nb_seeds; s++) {
+            seed_i[s] = row_dist(rng());
+            seed_j[s] = col_dist(rng());
+            owner[seed_i[s] * nb_cols + seed_j[s]] = static_cast<std::uint32_t>(s);
+        }
+
+        auto dist2 = [&](std::size_t i, std::size_t j, std::uint32_t s) {
+            std::int64_t di = static_cast<std::int64_t>(i) - seed_i[s];
+            std::int64_t dj = static_cast<std::int64_t>(j) - seed_j[s];
+            return di * di + dj * dj;
+        };
+
+        // Jump flood: halving offsets propagate the nearest seed in
+        // O(N log N) total instead of the O(N * K) per-tile seed scan
+        std::vector<std::uint32_t> next(nb_rows * nb_cols);
+        std::size_t step = 1;
+        while (step * 2 < std::max(nb_rows, nb_cols)) {
+            step *= 2;
+        }
+        for (; step >= 1; step /= 2) {
+            // Each pass reads owner and writes next, so bands are
+            // independent and the join below is the halo exchange
+            parallel_for_rows(0, nb_rows, generation_threads_, [&, step](std::size_t band_r0, std::size_t band_r1) {
+            for (std::size_t i = band_r0; i < band_r1; i++) {
+                for (std::size_t j = 0; j < nb_cols; j++) {
+                    std::uint32_t best = owner[i * nb_cols + j];
+                    for (int oi = -1; oi <= 1; oi++) {
+                        for (int oj = -1; oj <= 1; oj++) {
+                            std::size_t ni = i + static_cast<std::size_t>(oi * static_cast<std::ptrdiff_t>(step));
+                            std::size_t nj = j + static_cast<std::size_t>(oj * static_cast<std::ptrdiff_t>(step));
+                            if (ni >= nb_rows || nj >= nb_cols) {
+                                continue; // off the grid, including wrap-around below zero
+                            }
+                            std::uint32_t candidate = owner[ni * nb_cols + nj];
+                            if (candidate == NO_OWNER) {
+                                continue;
+                            }
+                            if (best == NO_OWNER || dist2(i, j, candidate) < dist2(i, j, best)) {
+                                best = candidate;
+                            }
+                        }
+                    }
+                    next[i * nb_cols + j] = best;
+                }
+            }
+            });
+            owner.swap(next);
+        }
+
+        // Paint region borders as walls; interiors become floor
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        const std::uint8_t floor = static_cast<std::uint8_t>(DungeonTile::FLOOR);
+        std::uint8_t* grid = tiles().data();
+        for (std::size_t i = 0; i < nb_rows; i++) {
+            for (std::size_t j = 0; j < nb_cols; j++) {
+                std::size_t cell = i * nb_cols + j;
+                bool border = (i == 0 || j == 0 || i == nb_rows - 1 || j == nb_cols - 1)
+                           || owner[cell] != owner[cell + 1]
+                           || owner[cell] != owner[cell + nb_cols];
+                grid[cell] = border ? wall : floor;
+            }
+        }
+    }
+
+    void RogueDungeon::generate_perlin(){
+        const std::size_t nb_rows = rows();
+        const std::size_t nb_cols = cols();
+        if (nb_rows < 3 || nb_cols < 3) {
+            return;
+        }
+        const std::uint8_t wall = static_cast<std::uint8_t>(DungeonTile::WALL);
+        const std::uint8_t floor = static_cast<std::uint8_t>(DungeonTile::FLOOR);
+
+        // The table is shared across every dungeon with this seed; only
+        // the first one pays for building it
+        PerlinNoise noise(PerlinTable::shared(seed()));
+
+        // About six noise features across the shorter dimension
+        const float frequency = 6.0f / static_cast<float>(std::min(nb_rows, nb_cols));
+
+        // Row-at-a-time evaluation: the y terms are fixed per row and the
+        // inner loop walks x through contiguous tiles
+        for (std::size_t i = 0; i < nb_rows; i++) {
+            std::uint8_t* out = tiles().row(i);
+            const float y = static_cast<float>(i) * frequency;
+            for (std::size_t j = 0; j < nb_cols; j++) {
+                float n = noise.fractal(static_cast<float>(j) * frequency, y, 4);
+                out[j] = (n > 0.0f) ? floor : wall;
+            }
+        }
+        fill_rect(0, 0, 1, nb_cols, wall);
+        fill_rect(nb_rows - 1, 0, nb_rows, nb_cols, wall);
+        fill_rect(0, 0, nb_rows, 1, wall);
+        fill_rect(0, nb_cols - 1, nb_rows, nb_cols, wall);
+    }
+
+    void RogueDungeon::set_generation_threads(std::size_t nb_threads){
+        if (nb_threads == 0) {
+            nb_threads = std::thread::hardware_concurrency();
+            if (nb_threads == 0) {
+                nb_threads = 1;
+            }
+        }
+        generation_threads_ = nb_threads;
+    }
+
+    void RogueDungeon::generate_random_dungeon_cellular_automata_step(){
+        cellular_automata_smooth(tiles(),
+                                 static_cast<std::uint8_t>(DungeonTile::WALL),
+                                 static_cast<std::uint8_t>(DungeonTile::FLOOR),
+                                 generation_threads_);
+    }
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,13 @@
+#pragma once
+
 #include "array_2D.hpp"
+#include "pathfinding.hpp"
+#include "region_index.hpp"
+#include "rng.hpp"
+#include "union_find.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <tuple>
 #include <vector>
 #include <random>
@@ -14,6 +21,9 @@
 
 namespace daedalus {
 
+    class CompressedDungeon;
+    class ConcurrentTileView;
+
     /**
      * @enum DungeonTile
      * @brief Enumeration for different types of tiles in the dungeon.
@@ -41,27 +51,125 @@ namespace daedalus {
     /**
      * @class Dungeon
      * @brief Base class representing a dungeon.
+     *
+     * The const query surface (tile access, is_wall/is_exit, pathfinding,
+     * flow fields, exports) touches no shared mutable state, so a generated
+     * dungeon can be read from any number of threads concurrently without
+     * locks, as long as no thread mutates it at the same time.
      */
     class Dungeon {
+        friend class ConcurrentTileView;
+
         private:
             Array_2D<std::uint8_t> tiles_; /**< 2D array representing the dungeon tiles */
             std::tuple<std::size_t, std::size_t> entrance_pos_; /**< Position of the entrance tile */
             std::tuple<std::size_t, std::size_t> exit_pos_; /**< Position of the exit tile */
             unsigned long seed_; /**< Seed for random generation */
-            std::mt19937 rng_; /**< Random number generator */
-        
+            DefaultRng rng_; /**< Random number generator */
+            DungeonGenerationMethod method_ = DungeonGenerationMethod::NAIVE; /**< Method used by the last generation run */
+            UnionFind connectivity_; /**< Union-find over the tiles, one set per walkable region */
+            bool connectivity_valid_ = false; /**< Whether connectivity_ reflects the current tiles */
+
+            /**
+             * @brief One journaled tile write, for replication diffs.
+             */
+            struct TileWrite {
+                std::uint32_t i; /**< Row of the write */
+                std::uint32_t j; /**< Column of the write */
+                std::uint8_t value; /**< Tile value written */
+            };
+
+            bool replication_enabled_ = false; /**< Whether tile writes are journaled */
+            std::vector<TileWrite> journal_; /**< Writes since the journal base version */
+            std::uint64_t journal_base_ = 0; /**< Version of the journal's first entry */
+
+            /**
+             * @brief Append a write to the replication journal when enabled.
+             * @param i Row of the write.
+             * @param j Column of the write.
+             * @param tile Tile value written.
+             */
+            void journal_write(std::size_t i, std::size_t j, std::uint8_t tile);
+
+
+            /**
+             * @brief Rebuild the connectivity structure from the current tiles.
+             */
+            void rebuild_connectivity();
+
+        protected:
+            Dungeon(const Dungeon&) = default;
+
+            /**
+             * @brief Access the random number generator, for use by generation steps.
+             * @return Reference to the random number generator.
+             */
+            DefaultRng& rng() { return rng_; }
+
+            /**
+             * @brief Access the tile storage directly, for use by generation steps.
+             * @return Reference to the tile array.
+             */
+            Array_2D<std::uint8_t>& tiles() { return tiles_; }
+
+            /**
+             * @brief Record the method used by the current generation run.
+             * @param method Method being used.
+             */
+            void set_generation_method(DungeonGenerationMethod method) { method_ = method; }
+
+            /**
+             * @brief Drop the replication journal after a change it did not observe.
+             */
+            void invalidate_replication_history();
+
         public:
             /**
              * @brief Constructor to initialize the dungeon with given rows and columns.
              * @param rows Number of rows in the dungeon.
              * @param cols Number of columns in the dungeon.
              */
-            Dungeon(std::size_t rows, std::size_t cols,unsigned long seed = std::chrono::system_clock::now().time_since_epoch().count()) : 
-            tiles_(rows, cols), 
+            Dungeon(std::size_t rows, std::size_t cols,unsigned long seed = std::chrono::system_clock::now().time_since_epoch().count()) :
+            tiles_(rows, cols),
             seed_(seed),
             rng_(seed) {
             };
 
+            /**
+             * @brief Constructor seeding the dungeon from a seed hierarchy.
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed Sequence whose seed value the dungeon draws from.
+             */
+            Dungeon(std::size_t rows, std::size_t cols, SeedSequence seed) :
+            Dungeon(rows, cols, static_cast<unsigned long>(seed.seed())) {
+            };
+
+            /**
+             * @brief Move constructor; transfers the tiles, no copy.
+             */
+            Dungeon(Dungeon&&) noexcept = default;
+
+            /**
+             * @brief Move assignment; transfers the tiles, no copy.
+             * @return Reference to this dungeon.
+             */
+            Dungeon& operator=(Dungeon&&) noexcept = default;
+
+            Dungeon& operator=(const Dungeon&) = delete;
+
+            /**
+             * @brief Deliberately deep-copy the dungeon.
+             *
+             * The copy constructor is protected so a full copy of the tile
+             * storage cannot happen by accident; handing a dungeon between
+             * threads is a move, and clone() is the explicit spelling for
+             * the rare case where a real duplicate is wanted.
+             *
+             * @return An independent copy of the dungeon.
+             */
+            Dungeon clone() const { return Dungeon(*this); }
+
             /**
              * @brief Overloaded operator to access a tile at a given position.
              * @param i Row index.
@@ -90,12 +198,59 @@ namespace daedalus {
              */
             void set_tile(std::size_t i, std::size_t j, std::uint8_t tile);
 
+            /**
+             * @brief Fill a rectangle of tiles with a value.
+             *
+             * Half-open range, clamped to the map bounds; rows are written
+             * at memset speed instead of per-tile calls.
+             *
+             * @param r0 First row of the rectangle.
+             * @param c0 First column of the rectangle.
+             * @param r1 One past the last row of the rectangle.
+             * @param c1 One past the last column of the rectangle.
+             * @param tile Tile value to fill with.
+             */
+            void fill_rect(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1, std::uint8_t tile);
+
+            /**
+             * @brief Count the tiles equal to a value.
+             * @param tile Tile value to count.
+             * @return Number of matching tiles.
+             */
+            std::size_t count_tiles(std::uint8_t tile) const;
+
+            /**
+             * @brief Flood-fill the connected region containing a tile.
+             *
+             * Scanline fill over the 4-connected region of tiles equal to
+             * the start tile's value.
+             *
+             * @param i Row index of the start tile.
+             * @param j Column index of the start tile.
+             * @param tile Tile value to fill the region with.
+             * @return Number of tiles filled.
+             */
+            std::size_t flood_fill(std::size_t i, std::size_t j, std::uint8_t tile);
+
             /**
              * @brief Export dungeon data to a vector.
              * @param v Vector to store the dungeon data.
              */
             virtual void export_data(std::vector<std::uint8_t>& v) const;
 
+            /**
+             * @brief Get a read-only view of the tile storage, without copying.
+             * @return Const reference to the tile array.
+             */
+            const Array_2D<std::uint8_t>& tiles_view() const;
+
+            /**
+             * @brief Get a read-only pointer to the start of a tile row, without copying.
+             * @param i Row index.
+             * @return Const pointer to the first tile of the row.
+             */
+            const std::uint8_t* row(std::size_t i) const;
+
             /**
              * @brief Check if a tile at a given position is a wall.
              * @param i Row index.
@@ -134,38 +289,347 @@ namespace daedalus {
             void set_exit(std::size_t i, std::size_t j);
 
             /**
-             * @brief Find a path using Dijkstra's algorithm.
+             * @brief Enable dirty-row tracking on the tile storage.
+             */
+            void enable_dirty_tracking();
+
+            /**
+             * @brief Start journaling tile writes for replication diffs.
+             *
+             * From here on, set_tile, fill_rect and flood_fill writes are
+             * recorded so spectators can be brought up to date with a
+             * diff instead of a full tile transfer. Regenerating the
+             * dungeon drops the history, since the generation kernels
+             * write rows the journal does not observe.
+             */
+            void enable_replication();
+
+            /**
+             * @brief Get the current state version token.
+             * @return The version; grows with every journaled write.
+             */
+            std::uint64_t snapshot() const;
+
+            /**
+             * @brief Emit the tile changes since a version, in wire format.
+             *
+             * The buffer starts with three little-endian 64-bit fields -
+             * from-version, to-version, entry count - followed by one
+             * entry per change: 32-bit row, 32-bit column, 8-bit value,
+             * all little-endian, in write order.
+             *
+             * @param since_version Version the receiver is at.
+             * @param out Buffer the patch is appended to.
+             * @return True if the history since that version is available;
+             *         false if it was trimmed or invalidated, in which
+             *         case the receiver needs a full transfer.
+             */
+            bool diff(std::uint64_t since_version, std::vector<std::uint8_t>& out) const;
+
+            /**
+             * @brief Apply a patch produced by diff to this dungeon.
+             * @param patch The wire-format patch.
+             * @return True if the patch was well formed and applied.
+             */
+            bool apply_patch(const std::vector<std::uint8_t>& patch);
+
+            /**
+             * @brief Drop journal history older than a version.
+             *
+             * Call with the oldest version any receiver still needs, so
+             * the journal does not grow without bound.
+             *
+             * @param before_version Version before which history may go.
+             */
+            void discard_history(std::uint64_t before_version);
+
+            /**
+             * @brief Get the tile generation counter; bumped by every tracked write.
+             * @return The current generation.
+             */
+            std::uint64_t tile_generation() const;
+
+            /**
+             * @brief Fetch the indices of rows touched since the last fetch, and clear them.
+             * @param rows_out Vector to which the dirty row indices are appended.
+             */
+            void fetch_dirty_rows(std::vector<std::size_t>& rows_out);
+
+            /**
+             * @brief Get the seed used for random generation.
+             * @return The seed.
+             */
+            unsigned long seed() const;
+
+            /**
+             * @brief Get the entrance tile position.
+             * @return Tuple of (row, column) of the entrance.
+             */
+            std::tuple<std::size_t, std::size_t> entrance_pos() const;
+
+            /**
+             * @brief Get the exit tile position.
+             * @return Tuple of (row, column) of the exit.
+             */
+            std::tuple<std::size_t, std::size_t> exit_pos() const;
+
+            /**
+             * @brief Get the method used by the last generation run.
+             * @return The generation method.
+             */
+            DungeonGenerationMethod generation_method() const;
+
+            /**
+             * @brief Compress the dungeon for cold storage.
+             * @return The compressed representation.
+             */
+            CompressedDungeon compress() const;
+
+            /**
+             * @brief Rebuild a dungeon from its compressed representation.
+             * @param compressed Compressed dungeon to expand.
+             */
+            explicit Dungeon(const CompressedDungeon& compressed);
+
+            /**
+             * @brief Save the dungeon to a flat binary file.
+             * @param path Path of the file to write.
+             * @return True if the file was written, false otherwise.
+             */
+            bool save(const std::string& path) const;
+
+            /**
+             * @brief Load a dungeon from a flat binary file written by save.
+             * @param path Path of the file to read.
+             * @return The loaded dungeon; a 0x0 dungeon if the file could not be read.
+             */
+            static Dungeon load(const std::string& path);
+
+            /**
+             * @brief Find a shortest path between two tiles.
+             *
+             * A* over the 4-connected grid with a Manhattan heuristic and a
+             * dial (bucket) queue, since all step costs are one. Walls block;
+             * every other tile is walkable. The context carries the scratch
+             * arrays and the resulting path, so repeated queries on the same
+             * dungeon do not reallocate.
+             *
+             * @param from Start position.
+             * @param to Goal position.
+             * @param ctx Scratch state, reused across queries.
              * @return True if a path is found, false otherwise.
              */
-            bool find_path_djikstra();
+            bool find_path(std::tuple<std::size_t, std::size_t> from,
+                           std::tuple<std::size_t, std::size_t> to,
+                           PathfindingContext& ctx) const;
+
+            /**
+             * @brief Check whether the entrance and the exit are connected.
+             *
+             * Connectivity is answered from an incrementally maintained
+             * union-find: floor writes through set_tile union with their
+             * neighbors, so after one lazy rebuild (following generation,
+             * bulk fills, or wall writes, which can split regions) repeated
+             * checks cost almost nothing instead of a full grid search.
+             * Unlike the const query surface, this may update internal
+             * caches and is not safe to call concurrently.
+             *
+             * @return True if a walkable path between entrance and exit exists.
+             */
+            bool validate_connectivity();
+
+            /**
+             * @brief Check whether two tiles are connected by walkable tiles.
+             * @param a First position.
+             * @param b Second position.
+             * @return True if a walkable path between the positions exists.
+             */
+            bool connected(std::tuple<std::size_t, std::size_t> a, std::tuple<std::size_t, std::size_t> b);
+
+            /**
+             * @brief Compute a flow field toward a goal tile.
+             *
+             * A single breadth-first sweep fills the distance of every tile
+             * to the goal and the direction of its next step, which any
+             * number of agents can then follow without running their own
+             * path queries.
+             *
+             * @param goal Goal position.
+             * @return The computed field.
+             */
+            FlowField compute_flow_field(std::tuple<std::size_t, std::size_t> goal) const;
+
+            /**
+             * @brief Compute a flow field toward the nearest of several goal tiles.
+             * @param goals Goal positions; out-of-bounds and wall goals are ignored.
+             * @return The computed field.
+             */
+            FlowField compute_flow_field(const std::vector<std::tuple<std::size_t, std::size_t>>& goals) const;
+
+            /**
+             * @brief Find a path from the entrance to the exit using Dijkstra's algorithm.
+             *
+             * Scratch state and the resulting hot path are thread-local, so
+             * any number of threads may query the same generated dungeon
+             * concurrently without locks.
+             *
+             * @return True if a path is found, false otherwise.
+             */
+            bool find_path_djikstra() const;
 
             /**
              * @brief Get the hot path found by Dijkstra's algorithm.
+             *
+             * Returns the path of the calling thread's most recent
+             * find_path_djikstra call on this dungeon.
+             *
              * @return Vector of positions representing the hot path.
              */
             std::vector<std::tuple<std::size_t, std::size_t>> get_hot_path_djikstra() const;
     };
 
+    /**
+     * @struct BspNode
+     * @brief One node of a binary space partitioning tree.
+     *
+     * Nodes live in a flat pool and reference their children by index, so
+     * building and walking the tree stays allocation-free and
+     * cache-resident; a node's two children are adjacent in the pool.
+     */
+    struct BspNode {
+        std::uint32_t top;    /**< First row of the node's region */
+        std::uint32_t left;   /**< First column of the node's region */
+        std::uint32_t height; /**< Number of rows in the node's region */
+        std::uint32_t width;  /**< Number of columns in the node's region */
+        std::int32_t first_child = -1; /**< Pool index of the first child, -1 for a leaf */
+        std::uint32_t room_center_i = 0; /**< Row of the carved room's center (leaves) */
+        std::uint32_t room_center_j = 0; /**< Column of the carved room's center (leaves) */
+    };
+
     /**
      * @class RogueDungeon
      * @brief Derived class representing a rogue-like dungeon.
      */
     class RogueDungeon : public Dungeon {
+        private:
+            std::vector<BspNode> bsp_nodes_; /**< Flat node pool of the current BSP tree */
+            std::size_t bsp_next_leaf_ = 0; /**< Pool index the next BSP step resumes scanning from */
+            std::size_t generation_steps_remaining_ = 0; /**< Steps left in the current stepwise generation run */
+            std::size_t drunk_i_ = 0; /**< Row of the drunken walker */
+            std::size_t drunk_j_ = 0; /**< Column of the drunken walker */
+            RegionIndex region_index_; /**< Spatial metadata recorded during generation */
+            std::size_t generation_threads_ = 1; /**< Thread bands used by the parallelizable generation kernels */
+
+            /**
+             * @brief Carve an L-shaped corridor, recording door tiles in the region index.
+             * @param from Starting position of the corridor.
+             * @param to Ending position of the corridor.
+             */
+            void carve_corridor(std::tuple<std::size_t, std::size_t> from, std::tuple<std::size_t, std::size_t> to);
+            std::tuple<std::size_t, std::size_t> first_room_center_; /**< Center of the first room carved by the current generation run */
+            std::tuple<std::size_t, std::size_t> last_room_center_; /**< Center of the most recently carved room */
+            bool has_room_ = false; /**< Whether any room has been carved yet */
+
+            /**
+             * @brief Place the entrance on the first floor tile and the exit on the last one.
+             */
+            void place_entrance_and_exit_on_floor();
+
+            /**
+             * @brief Build the BSP tree into the node pool by recursive splitting.
+             */
+            void build_bsp_tree();
+
+            /**
+             * @brief Generate a Voronoi partition with the jump-flood algorithm.
+             */
+            void generate_voronoi();
+
+            /**
+             * @brief Generate terrain from multi-octave Perlin noise.
+             */
+            void generate_perlin();
+
+        protected:
+            RogueDungeon(const RogueDungeon&) = default;
+
         public:
             /**
              * @brief Constructor to initialize the rogue dungeon with given rows and columns.
              * @param rows Number of rows in the dungeon.
              * @param cols Number of columns in the dungeon.
+             * @param seed Seed for random generation.
+             */
+            RogueDungeon(std::size_t rows, std::size_t cols, unsigned long seed = std::chrono::system_clock::now().time_since_epoch().count());
+
+            /**
+             * @brief Constructor seeding the rogue dungeon from a seed hierarchy.
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed Sequence whose seed value the dungeon draws from.
+             */
+            RogueDungeon(std::size_t rows, std::size_t cols, SeedSequence seed) :
+            RogueDungeon(rows, cols, static_cast<unsigned long>(seed.seed())) {
+            };
+
+            /**
+             * @brief Move constructor; transfers the tiles, no copy.
+             */
+            RogueDungeon(RogueDungeon&&) noexcept = default;
+
+            /**
+             * @brief Move assignment; transfers the tiles, no copy.
+             * @return Reference to this dungeon.
+             */
+            RogueDungeon& operator=(RogueDungeon&&) noexcept = default;
+
+            /**
+             * @brief Deliberately deep-copy the dungeon.
+             * @return An independent copy of the dungeon.
+             */
+            RogueDungeon clone() const { return RogueDungeon(*this); }
+
+            /**
+             * @brief Generate a dungeon in one call, returned by value.
+             *
+             * Factory form of construct-then-generate; the result is moved
+             * (or elided) into the caller, so generation threads can hand
+             * finished maps to session threads without a copy.
+             *
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed Seed for random generation.
+             * @param method Method to use for dungeon generation.
+             * @return The generated dungeon.
+             */
+            static RogueDungeon generate(std::size_t rows, std::size_t cols, unsigned long seed,
+                                         DungeonGenerationMethod method);
+
+            /**
+             * @brief Get the spatial metadata recorded by the last generation run.
+             * @return The region index.
              */
-            RogueDungeon(std::size_t rows, std::size_t cols);
+            const RegionIndex& region_index() const { return region_index_; }
+
+            /**
+             * @brief Set the number of threads the generation kernels may use.
+             *
+             * Applies to the kernels that parallelize over horizontal
+             * bands (cellular automata smoothing, the Voronoi flood
+             * passes). Results are bit-identical for any thread count;
+             * 0 means one band per hardware thread.
+             *
+             * @param nb_threads Number of thread bands.
+             */
+            void set_generation_threads(std::size_t nb_threads);
 
             /**
              * @brief Place a room in the dungeon.
-             * @param from Starting position of the room.
-             * @param to Ending position of the room.
+             * @param from Position of the room's top-left corner, inclusive.
+             * @param to Position of the room's bottom-right corner, inclusive.
              * @return True if the room is placed successfully, false otherwise.
              */
-            bool place_room(std::tuple<std::size_t> from, std::tuple<std::size_t> to);
+            bool place_room(std::tuple<std::size_t, std::size_t> from, std::tuple<std::size_t, std::size_t> to);
 
             /**
              * @brief Generate a random dungeon using a specified method.
@@ -174,6 +638,31 @@ namespace daedalus {
              */
             void generate_random_dungeon(DungeonGenerationMethod method) override;
 
+            /**
+             * @brief Start a stepwise generation run.
+             *
+             * Prepares the map for the given method (wall or noise fill,
+             * BSP tree build, step budget); the run is then driven by
+             * advance_step_generation and finished by end_step_generation.
+             * generate_random_dungeon is the one-call form of the same
+             * sequence; the split exists so callers can render or yield
+             * between steps.
+             *
+             * @param method Method to use for dungeon generation.
+             */
+            void begin_step_generation(DungeonGenerationMethod method);
+
+            /**
+             * @brief Perform one step of the current stepwise generation run.
+             * @return True if a step was performed, false once the run is complete.
+             */
+            bool advance_step_generation();
+
+            /**
+             * @brief Finish a stepwise generation run, placing the entrance and exit.
+             */
+            void end_step_generation();
+
             /**
              * @brief Perform a step of naive dungeon generation.
              */
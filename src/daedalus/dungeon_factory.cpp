@@ -0,0 +1,142 @@
+#include "dungeon_factory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace daedalus {
+
+    namespace {
+        /**
+         * @brief The library's shared worker pool for asynchronous generation.
+         *
+         * Started lazily on first use, one thread per hardware thread;
+         * joined when the process shuts the library down.
+         */
+        class WorkerPool {
+        public:
+            static WorkerPool& instance() {
+                static WorkerPool pool;
+                return pool;
+            }
+
+            void submit(std::function<void()> task) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    tasks_.push_back(std::move(task));
+                }
+                wake_.notify_one();
+            }
+
+        private:
+            WorkerPool() {
+                std::size_t nb_workers = std::thread::hardware_concurrency();
+                if (nb_workers == 0) {
+                    nb_workers = 1;
+                }
+                for (std::size_t w = 0; w < nb_workers; w++) {
+                    workers_.emplace_back([this]() {
+                        for (;;) {
+                            std::function<void()> task;
+                            {
+                                std::unique_lock<std::mutex> lock(mutex_);
+                                wake_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                                if (stop_ && tasks_.empty()) {
+                                    return;
+                                }
+                                task = std::move(tasks_.front());
+                                tasks_.pop_front();
+                            }
+                            task();
+                        }
+                    });
+                }
+            }
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                wake_.notify_all();
+                for (std::thread& worker : workers_) {
+                    worker.join();
+                }
+            }
+
+            std::vector<std::thread> workers_; ///< The pool threads.
+            std::deque<std::function<void()>> tasks_; ///< Pending tasks.
+            std::mutex mutex_; ///< Guards the task queue.
+            std::condition_variable wake_; ///< Signals queued work or shutdown.
+            bool stop_ = false; ///< Set during shutdown.
+        };
+    }
+
+    std::vector<RogueDungeon> DungeonFactory::generate_batch(std::size_t count,
+                                                             std::size_t rows,
+                                                             std::size_t cols,
+                                                             DungeonGenerationMethod method,
+                                                             const std::vector<unsigned long>& seeds,
+                                                             std::size_t nb_workers){
+        std::vector<RogueDungeon> dungeons;
+        dungeons.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            unsigned long seed = (i < seeds.size()) ? seeds[i] : static_cast<unsigned long>(i);
+            dungeons.emplace_back(rows, cols, seed);
+        }
+
+        if (nb_workers == 0) {
+            nb_workers = std::thread::hardware_concurrency();
+            if (nb_workers == 0) {
+                nb_workers = 1;
+            }
+        }
+        nb_workers = std::min(nb_workers, count);
+
+        if (nb_workers <= 1) {
+            for (RogueDungeon& dungeon : dungeons) {
+                dungeon.generate_random_dungeon(method);
+            }
+            return dungeons;
+        }
+
+        // Workers steal the next unclaimed dungeon; each one only touches its
+        // own seeded state, so the schedule cannot affect the generated tiles.
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> workers;
+        workers.reserve(nb_workers);
+        for (std::size_t w = 0; w < nb_workers; w++) {
+            workers.emplace_back([&dungeons, &next, method]() {
+                for (std::size_t i = next.fetch_add(1); i < dungeons.size(); i = next.fetch_add(1)) {
+                    dungeons[i].generate_random_dungeon(method);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return dungeons;
+    }
+
+    std::future<RogueDungeon> DungeonFactory::generate_async(std::size_t rows,
+                                                             std::size_t cols,
+                                                             unsigned long seed,
+                                                             DungeonGenerationMethod method,
+                                                             CancellationToken token){
+        auto promise = std::make_shared<std::promise<RogueDungeon>>();
+        std::future<RogueDungeon> future = promise->get_future();
+        WorkerPool::instance().submit([promise, rows, cols, seed, method, token]() {
+            RogueDungeon dungeon(rows, cols, seed);
+            dungeon.begin_step_generation(method);
+            while (!token.cancelled() && dungeon.advance_step_generation()) {
+            }
+            dungeon.end_step_generation();
+            promise->set_value(std::move(dungeon));
+        });
+        return future;
+    }
+}
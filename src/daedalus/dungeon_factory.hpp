@@ -0,0 +1,100 @@
+#pragma once
+
+#include "dungeon.hpp"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <vector>
+
+/**
+ * @file dungeon_factory.hpp
+ * @brief This file contains the definition of the DungeonFactory class, which
+ *        generates dungeons in bulk over a worker pool.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class CancellationToken
+     * @brief Shared flag for abandoning in-flight asynchronous generation.
+     *
+     * Copies share one flag; cancelling any copy asks the generation run
+     * to stop at its next step boundary.
+     */
+    class CancellationToken {
+        public:
+            /**
+             * @brief Constructor for a fresh, uncancelled token.
+             */
+            CancellationToken() :
+            cancelled_(std::make_shared<std::atomic<bool>>(false)) {
+            };
+
+            /**
+             * @brief Request cancellation.
+             */
+            void cancel() { cancelled_->store(true); }
+
+            /**
+             * @brief Check whether cancellation was requested.
+             * @return True if cancel was called on any copy of the token.
+             */
+            bool cancelled() const { return cancelled_->load(); }
+
+        private:
+            std::shared_ptr<std::atomic<bool>> cancelled_; /**< The shared flag */
+    };
+
+    /**
+     * @class DungeonFactory
+     * @brief Factory generating batches of dungeons in parallel.
+     *
+     * Each dungeon draws only from its own seeded generator, so a batch
+     * reproduces byte-identical tiles for the same seed list regardless of
+     * the number of worker threads.
+     */
+    class DungeonFactory {
+        public:
+            /**
+             * @brief Generate a batch of dungeons in parallel over a worker pool.
+             * @param count Number of dungeons to generate.
+             * @param rows Number of rows in each dungeon.
+             * @param cols Number of columns in each dungeon.
+             * @param method Method to use for dungeon generation.
+             * @param seeds One seed per dungeon; when fewer seeds than dungeons
+             *        are supplied, the dungeon index is used as the seed for the
+             *        remainder.
+             * @param nb_workers Number of worker threads, 0 for one per hardware thread.
+             * @return Vector of generated dungeons, in seed order.
+             */
+            static std::vector<RogueDungeon> generate_batch(std::size_t count,
+                                                            std::size_t rows,
+                                                            std::size_t cols,
+                                                            DungeonGenerationMethod method,
+                                                            const std::vector<unsigned long>& seeds,
+                                                            std::size_t nb_workers = 0);
+
+            /**
+             * @brief Generate one dungeon asynchronously on the library's worker pool.
+             *
+             * The caller keeps ticking while the map generates; the future
+             * delivers the finished dungeon by move. Cancellation is
+             * polled between generation steps: a cancelled run stops
+             * consuming CPU at the next step boundary and resolves the
+             * future with the dungeon as far as it got.
+             *
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed Seed for random generation.
+             * @param method Method to use for dungeon generation.
+             * @param token Token to abandon the run early.
+             * @return Future resolving to the generated dungeon.
+             */
+            static std::future<RogueDungeon> generate_async(std::size_t rows,
+                                                            std::size_t cols,
+                                                            unsigned long seed,
+                                                            DungeonGenerationMethod method,
+                                                            CancellationToken token = CancellationToken());
+    };
+}
@@ -0,0 +1,107 @@
+#include "dungeon_file.hpp"
+#include <iostream>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace daedalus {
+
+    MappedDungeon::MappedDungeon(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Could not open dungeon file " << path << std::endl;
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(DungeonFileHeader)) {
+            std::cerr << "Dungeon file " << path << " is truncated" << std::endl;
+            ::close(fd);
+            return;
+        }
+        std::size_t size = st.st_size;
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Could not map dungeon file " << path << std::endl;
+            return;
+        }
+        const DungeonFileHeader* header = static_cast<const DungeonFileHeader*>(mapping);
+        std::size_t payload = size - sizeof(DungeonFileHeader);
+        // The division form avoids overflowing rows * cols on a crafted header
+        if (header->magic != DungeonFileHeader::MAGIC
+            || (header->rows != 0 && header->cols > payload / header->rows)) {
+            std::cerr << "Dungeon file " << path << " is not a valid dungeon file" << std::endl;
+            ::munmap(mapping, size);
+            return;
+        }
+        mapping_ = mapping;
+        mapping_size_ = size;
+        header_ = header;
+        tiles_ = static_cast<const std::uint8_t*>(mapping) + sizeof(DungeonFileHeader);
+    }
+
+    MappedDungeon::~MappedDungeon() {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapping_size_);
+        }
+    }
+
+    MappedDungeon::MappedDungeon(MappedDungeon&& other) noexcept :
+    mapping_(std::exchange(other.mapping_, nullptr)),
+    mapping_size_(std::exchange(other.mapping_size_, 0)),
+    header_(std::exchange(other.header_, nullptr)),
+    tiles_(std::exchange(other.tiles_, nullptr)) {
+    }
+
+    MappedDungeon& MappedDungeon::operator=(MappedDungeon&& other) noexcept {
+        if (this != &other) {
+            if (mapping_ != nullptr) {
+                ::munmap(mapping_, mapping_size_);
+            }
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapping_size_ = std::exchange(other.mapping_size_, 0);
+            header_ = std::exchange(other.header_, nullptr);
+            tiles_ = std::exchange(other.tiles_, nullptr);
+        }
+        return *this;
+    }
+
+    bool MappedDungeon::valid() const {
+        return mapping_ != nullptr;
+    }
+
+    std::size_t MappedDungeon::rows() const {
+        return header_->rows;
+    }
+
+    std::size_t MappedDungeon::cols() const {
+        return header_->cols;
+    }
+
+    unsigned long MappedDungeon::seed() const {
+        return header_->seed;
+    }
+
+    std::tuple<std::size_t, std::size_t> MappedDungeon::entrance_pos() const {
+        return std::make_tuple(header_->entrance_i, header_->entrance_j);
+    }
+
+    std::tuple<std::size_t, std::size_t> MappedDungeon::exit_pos() const {
+        return std::make_tuple(header_->exit_i, header_->exit_j);
+    }
+
+    std::uint64_t MappedDungeon::generation_method() const {
+        return header_->method;
+    }
+
+    std::uint8_t MappedDungeon::operator()(std::size_t i, std::size_t j) const {
+        return tiles_[i * header_->cols + j];
+    }
+
+    const std::uint8_t* MappedDungeon::data() const {
+        return tiles_;
+    }
+}
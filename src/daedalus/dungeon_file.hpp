@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+
+/**
+ * @file dungeon_file.hpp
+ * @brief The flat binary dungeon file format and a memory-mapped reader for it.
+ */
+
+namespace daedalus {
+
+    /**
+     * @struct DungeonFileHeader
+     * @brief Fixed-size header at the start of a dungeon file.
+     *
+     * All fields are little-endian. The tile payload follows the header
+     * directly: rows * cols bytes in row-major order.
+     */
+    struct DungeonFileHeader {
+        static constexpr std::uint64_t MAGIC = 0x3150414d44454144ULL; /**< "DAEDMAP1" */
+
+        std::uint64_t magic;      /**< File identification, must equal MAGIC */
+        std::uint64_t rows;       /**< Number of rows in the dungeon */
+        std::uint64_t cols;       /**< Number of columns in the dungeon */
+        std::uint64_t seed;       /**< Seed the dungeon was generated from */
+        std::uint64_t entrance_i; /**< Row of the entrance tile */
+        std::uint64_t entrance_j; /**< Column of the entrance tile */
+        std::uint64_t exit_i;     /**< Row of the exit tile */
+        std::uint64_t exit_j;     /**< Column of the exit tile */
+        std::uint64_t method;     /**< DungeonGenerationMethod the dungeon was generated with */
+    };
+
+    /**
+     * @class MappedDungeon
+     * @brief Read-only view of a dungeon file opened with mmap.
+     *
+     * Opening does not read the tile payload; pages are faulted in lazily
+     * as tiles are accessed, so a large archive opens in constant time.
+     * The view is valid for the lifetime of this object.
+     */
+    class MappedDungeon {
+        public:
+            /**
+             * @brief Open a dungeon file written by Dungeon::save.
+             * @param path Path of the file to map.
+             */
+            explicit MappedDungeon(const std::string& path);
+
+            /**
+             * @brief Unmaps the file.
+             */
+            ~MappedDungeon();
+
+            MappedDungeon(const MappedDungeon&) = delete;
+            MappedDungeon& operator=(const MappedDungeon&) = delete;
+
+            /**
+             * @brief Move constructor; the source is left empty.
+             * @param other Mapped dungeon to take over.
+             */
+            MappedDungeon(MappedDungeon&& other) noexcept;
+
+            /**
+             * @brief Move assignment; the source is left empty.
+             * @param other Mapped dungeon to take over.
+             * @return Reference to this object.
+             */
+            MappedDungeon& operator=(MappedDungeon&& other) noexcept;
+
+            /**
+             * @brief Check whether the file was mapped successfully.
+             * @return True if the dungeon can be read.
+             */
+            bool valid() const;
+
+            /**
+             * @brief Get the number of rows in the dungeon.
+             * @return Number of rows.
+             */
+            std::size_t rows() const;
+
+            /**
+             * @brief Get the number of columns in the dungeon.
+             * @return Number of columns.
+             */
+            std::size_t cols() const;
+
+            /**
+             * @brief Get the seed the dungeon was generated from.
+             * @return The seed.
+             */
+            unsigned long seed() const;
+
+            /**
+             * @brief Get the entrance tile position.
+             * @return Tuple of (row, column) of the entrance.
+             */
+            std::tuple<std::size_t, std::size_t> entrance_pos() const;
+
+            /**
+             * @brief Get the exit tile position.
+             * @return Tuple of (row, column) of the exit.
+             */
+            std::tuple<std::size_t, std::size_t> exit_pos() const;
+
+            /**
+             * @brief Get the DungeonGenerationMethod value the dungeon was generated with.
+             * @return The stored method value.
+             */
+            std::uint64_t generation_method() const;
+
+            /**
+             * @brief Access a tile at a given position.
+             * @param i Row index.
+             * @param j Column index.
+             * @return The tile value.
+             */
+            std::uint8_t operator()(std::size_t i, std::size_t j) const;
+
+            /**
+             * @brief Get a read-only pointer to the mapped row-major tile payload.
+             * @return Pointer to the first tile.
+             */
+            const std::uint8_t* data() const;
+
+        private:
+            void* mapping_ = nullptr; /**< Base address of the mapping, or nullptr */
+            std::size_t mapping_size_ = 0; /**< Size of the mapping in bytes */
+            const DungeonFileHeader* header_ = nullptr; /**< Header at the start of the mapping */
+            const std::uint8_t* tiles_ = nullptr; /**< Tile payload following the header */
+    };
+}
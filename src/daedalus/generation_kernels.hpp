@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file generation_kernels.hpp
+ * @brief Generation kernels shared between the dynamic and static grids.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace daedalus {
+
+    /**
+     * @brief Run a row-range function over contiguous bands on a thread team.
+     *
+     * The calling thread processes the first band itself; the function is
+     * invoked as fn(row_begin, row_end) and must only write rows in its
+     * own band. All bands are joined before returning, so successive
+     * calls act as the barrier between dependent passes.
+     *
+     * @tparam Fn The row-range function type.
+     * @param first The first row of the range.
+     * @param last One past the last row of the range.
+     * @param nb_threads Number of bands; 1 runs inline with no threads.
+     * @param fn The function to run per band.
+     */
+    template <typename Fn>
+    void parallel_for_rows(std::size_t first, std::size_t last, std::size_t nb_threads, Fn&& fn) {
+        std::size_t nb_rows = (last > first) ? last - first : 0;
+        if (nb_threads > nb_rows) {
+            nb_threads = nb_rows;
+        }
+        if (nb_threads <= 1) {
+            if (nb_rows > 0) {
+                fn(first, last);
+            }
+            return;
+        }
+        std::vector<std::thread> team;
+        team.reserve(nb_threads - 1);
+        std::size_t band = nb_rows / nb_threads;
+        std::size_t extra = nb_rows % nb_threads;
+        std::size_t begin = first + band + (extra > 0 ? 1 : 0);
+        for (std::size_t t = 1; t < nb_threads; t++) {
+            std::size_t end = begin + band + (t < extra ? 1 : 0);
+            team.emplace_back([&fn, begin, end]() { fn(begin, end); });
+            begin = end;
+        }
+        fn(first, first + band + (extra > 0 ? 1 : 0));
+        for (std::thread& worker : team) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief One cellular automata smoothing pass over a tile grid.
+     *
+     * Works over any grid with rows()/cols()/row() (Array_2D,
+     * StaticArray_2D); when the extents are compile-time constants the
+     * inner loops run against known bounds. A 0/1 wall mask is built
+     * first, then 3x3 wall counts are computed row-at-a-time as
+     * straight-line adds over contiguous uint8 rows into a double
+     * buffer, which the compiler autovectorizes; the border stays wall.
+     *
+     * The pass parallelizes over horizontal bands when asked: the mask
+     * build, the smoothing and the write-back each run banded with a join
+     * in between, which stands in for the halo exchange - by the time a
+     * band reads its neighbor rows, the previous phase has fully
+     * finished. The result is bit-identical for any thread count.
+     *
+     * @tparam Grid The tile grid type.
+     * @param grid The grid to smooth.
+     * @param wall Tile value counted as wall.
+     * @param floor Tile value written for open cells.
+     * @param nb_threads Number of bands to process in parallel.
+     */
+    template <typename Grid>
+    void cellular_automata_smooth(Grid& grid, std::uint8_t wall, std::uint8_t floor, std::size_t nb_threads = 1) {
+        const std::size_t nb_rows = grid.rows();
+        const std::size_t nb_cols = grid.cols();
+        if (nb_rows < 3 || nb_cols < 3) {
+            return;
+        }
+
+        std::vector<std::uint8_t> mask(nb_rows * nb_cols);
+        parallel_for_rows(0, nb_rows, nb_threads, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; i++) {
+                const std::uint8_t* src = grid.row(i);
+                std::uint8_t* dst = &mask[i * nb_cols];
+                for (std::size_t j = 0; j < nb_cols; j++) {
+                    dst[j] = (src[j] == wall) ? 1 : 0;
+                }
+            }
+        });
+
+        std::vector<std::uint8_t> next(nb_rows * nb_cols, wall);
+        parallel_for_rows(1, nb_rows - 1, nb_threads, [&](std::size_t r0, std::size_t r1) {
+            std::vector<std::uint8_t> counts(nb_cols);
+            for (std::size_t i = r0; i < r1; i++) {
+                const std::uint8_t* up = &mask[(i - 1) * nb_cols];
+                const std::uint8_t* cur = &mask[i * nb_cols];
+                const std::uint8_t* down = &mask[(i + 1) * nb_cols];
+                for (std::size_t j = 1; j + 1 < nb_cols; j++) {
+                    counts[j] = up[j - 1] + up[j] + up[j + 1]
+                              + cur[j - 1] + cur[j] + cur[j + 1]
+                              + down[j - 1] + down[j] + down[j + 1];
+                }
+                std::uint8_t* out = &next[i * nb_cols];
+                for (std::size_t j = 1; j + 1 < nb_cols; j++) {
+                    out[j] = (counts[j] >= 5) ? wall : floor;
+                }
+            }
+        });
+
+        parallel_for_rows(0, nb_rows, nb_threads, [&](std::size_t r0, std::size_t r1) {
+            for (std::size_t i = r0; i < r1; i++) {
+                std::memcpy(grid.row(i), &next[i * nb_cols], nb_cols);
+            }
+        });
+    }
+}
@@ -0,0 +1,77 @@
+#include "generation_pipeline.hpp"
+#include <cstring>
+
+namespace daedalus {
+
+    GenerationPipeline::GenerationPipeline(std::size_t rows, std::size_t cols, unsigned long seed,
+                                           DungeonGenerationMethod method, std::size_t steps_per_frame) :
+    dungeon_(rows, cols, seed),
+    method_(method),
+    steps_per_frame_(steps_per_frame > 0 ? steps_per_frame : 1),
+    buffers_(3, Array_2D<std::uint8_t>(rows, cols)) {
+    }
+
+    GenerationPipeline::~GenerationPipeline() {
+        stop();
+    }
+
+    void GenerationPipeline::start() {
+        if (worker_.joinable()) {
+            return;
+        }
+        stop_requested_ = false;
+        worker_ = std::thread(&GenerationPipeline::run, this);
+    }
+
+    void GenerationPipeline::stop() {
+        stop_requested_ = true;
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    bool GenerationPipeline::finished() const {
+        return finished_;
+    }
+
+    std::uint64_t GenerationPipeline::steps_completed() const {
+        return steps_;
+    }
+
+    const Array_2D<std::uint8_t>& GenerationPipeline::current_frame() {
+        if (middle_.load(std::memory_order_acquire) & DIRTY) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & ~DIRTY;
+        }
+        return buffers_[front_];
+    }
+
+    const RogueDungeon& GenerationPipeline::result() const {
+        return dungeon_;
+    }
+
+    void GenerationPipeline::publish() {
+        Array_2D<std::uint8_t>& buffer = buffers_[back_];
+        std::memcpy(buffer.data(), dungeon_.tiles_view().data(), buffer.size());
+        back_ = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel) & ~DIRTY;
+    }
+
+    void GenerationPipeline::run() {
+        dungeon_.begin_step_generation(method_);
+        publish();
+        bool more = true;
+        while (more && !stop_requested_) {
+            for (std::size_t k = 0; k < steps_per_frame_ && more; k++) {
+                more = dungeon_.advance_step_generation();
+                if (more) {
+                    steps_++;
+                }
+            }
+            publish();
+        }
+        if (!stop_requested_) {
+            dungeon_.end_step_generation();
+            publish();
+            finished_ = true;
+        }
+    }
+}
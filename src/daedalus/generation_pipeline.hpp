@@ -0,0 +1,120 @@
+#pragma once
+
+#include "array_2D.hpp"
+#include "dungeon.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @file generation_pipeline.hpp
+ * @brief A double-buffered pipeline for rendering generation as it runs.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class GenerationPipeline
+     * @brief Runs stepwise generation on a worker thread and publishes
+     *        stable tile snapshots for a renderer.
+     *
+     * The worker advances the dungeon by a configurable number of steps,
+     * then copies the tiles into a spare buffer and publishes it with one
+     * atomic swap. The render thread picks up the newest published frame
+     * with current_frame() and can keep reading it while the worker
+     * prepares the next one, so neither side ever blocks the other.
+     *
+     * One producer (the worker) and one consumer (the thread calling
+     * current_frame) are supported.
+     */
+    class GenerationPipeline {
+        public:
+            /**
+             * @brief Constructor for a pipeline generating one dungeon.
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             * @param seed Seed for random generation.
+             * @param method Method to use for dungeon generation.
+             * @param steps_per_frame Generation steps batched between published frames.
+             */
+            GenerationPipeline(std::size_t rows, std::size_t cols, unsigned long seed,
+                               DungeonGenerationMethod method, std::size_t steps_per_frame = 1);
+
+            /**
+             * @brief Stops the worker if it is still running.
+             */
+            ~GenerationPipeline();
+
+            GenerationPipeline(const GenerationPipeline&) = delete;
+            GenerationPipeline& operator=(const GenerationPipeline&) = delete;
+
+            /**
+             * @brief Start the worker thread.
+             */
+            void start();
+
+            /**
+             * @brief Stop the worker thread, abandoning an unfinished run.
+             */
+            void stop();
+
+            /**
+             * @brief Check whether the generation run has completed.
+             * @return True once the final frame has been published.
+             */
+            bool finished() const;
+
+            /**
+             * @brief Get the number of generation steps completed so far.
+             * @return Number of steps.
+             */
+            std::uint64_t steps_completed() const;
+
+            /**
+             * @brief Get the newest published frame.
+             *
+             * Swaps in the latest snapshot if the worker published one
+             * since the last call; the returned buffer is stable until
+             * the next call.
+             *
+             * @return Reference to the frame's tiles.
+             */
+            const Array_2D<std::uint8_t>& current_frame();
+
+            /**
+             * @brief Get the generated dungeon.
+             *
+             * Only meaningful once finished() is true and the worker was
+             * joined with stop().
+             *
+             * @return Reference to the dungeon.
+             */
+            const RogueDungeon& result() const;
+
+        private:
+            /**
+             * @brief Copy the dungeon tiles into the back buffer and publish it.
+             */
+            void publish();
+
+            /**
+             * @brief Worker thread body: drive the stepwise generation.
+             */
+            void run();
+
+            static constexpr unsigned DIRTY = 4; /**< Flag marking an unconsumed published frame */
+
+            RogueDungeon dungeon_; /**< The dungeon being generated */
+            DungeonGenerationMethod method_; /**< Method used for generation */
+            std::size_t steps_per_frame_; /**< Steps batched between published frames */
+            std::vector<Array_2D<std::uint8_t>> buffers_; /**< The three snapshot buffers */
+            unsigned front_ = 0; /**< Buffer the consumer reads */
+            unsigned back_ = 1; /**< Buffer the worker writes */
+            std::atomic<unsigned> middle_{2}; /**< Buffer in flight, with DIRTY set when fresher than front */
+            std::atomic<bool> stop_requested_{false}; /**< Set by stop() to abandon the run */
+            std::atomic<bool> finished_{false}; /**< Set after the final frame is published */
+            std::atomic<std::uint64_t> steps_{0}; /**< Generation steps completed */
+            std::thread worker_; /**< The worker thread */
+    };
+}
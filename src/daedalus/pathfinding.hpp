@@ -0,0 +1,115 @@
+#pragma once
+
+#include "array_2D.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file pathfinding.hpp
+ * @brief Reusable scratch state for the pathfinding engine.
+ */
+
+namespace daedalus {
+
+    /**
+     * @enum FlowDirection
+     * @brief Step directions stored in a flow field.
+     */
+    enum class FlowDirection : std::uint8_t {
+        NONE = 0,  /**< Goal tile, or no route to a goal */
+        UP = 1,    /**< Step to the previous row */
+        DOWN = 2,  /**< Step to the next row */
+        LEFT = 3,  /**< Step to the previous column */
+        RIGHT = 4  /**< Step to the next column */
+    };
+
+    /**
+     * @struct FlowField
+     * @brief Distance and step-direction grids toward a set of goal tiles.
+     *
+     * One field is computed with a single sweep and then shared by every
+     * agent walking toward the goals: each agent just follows direction
+     * at its own tile.
+     */
+    struct FlowField {
+        static constexpr std::uint16_t UNREACHABLE = 0xFFFF; /**< Distance value of unreachable tiles */
+
+        Array_2D<std::uint16_t> distance; /**< Steps to the nearest goal, or UNREACHABLE */
+        Array_2D<std::uint8_t> direction; /**< FlowDirection of the next step toward the nearest goal */
+
+        /**
+         * @brief Constructs an empty field with the given dimensions.
+         * @param rows Number of rows.
+         * @param cols Number of columns.
+         */
+        FlowField(std::size_t rows, std::size_t cols) :
+        distance(rows, cols),
+        direction(rows, cols) {
+        };
+    };
+
+    /**
+     * @class PathfindingContext
+     * @brief Scratch state for Dungeon::find_path, reusable across queries.
+     *
+     * The distance, parent and bucket arrays are allocated once and kept
+     * between queries on same-sized maps; per-query invalidation uses a
+     * stamp instead of clearing, so repeated queries do not reallocate or
+     * touch the whole grid.
+     */
+    class PathfindingContext {
+        public:
+            /**
+             * @brief Get the path found by the last successful query.
+             * @return Vector of (row, column) positions from start to goal.
+             */
+            const std::vector<std::tuple<std::size_t, std::size_t>>& path() const {
+                return path_;
+            }
+
+            /**
+             * @brief Get the number of nodes expanded by the last query.
+             * @return Number of expansions.
+             */
+            std::size_t expanded() const {
+                return expanded_;
+            }
+
+        private:
+            friend class Dungeon;
+
+            /**
+             * @brief Prepare the scratch arrays for a query on a grid of the given size.
+             * @param nb_cells Number of cells in the grid.
+             */
+            void prepare(std::size_t nb_cells) {
+                if (dist_.size() < nb_cells) {
+                    dist_.resize(nb_cells);
+                    parent_.resize(nb_cells);
+                    stamp_of_.resize(nb_cells, 0);
+                }
+                stamp_++;
+                if (stamp_ == 0) {
+                    // Stamp wrapped; every stale entry now looks current
+                    std::fill(stamp_of_.begin(), stamp_of_.end(), 0);
+                    stamp_ = 1;
+                }
+                for (std::vector<std::uint32_t>& bucket : buckets_) {
+                    bucket.clear();
+                }
+                path_.clear();
+                expanded_ = 0;
+            }
+
+            std::vector<std::uint32_t> dist_; ///< Cost from the start, valid when the stamp matches.
+            std::vector<std::uint32_t> parent_; ///< Predecessor cell index, valid when the stamp matches.
+            std::vector<std::uint32_t> stamp_of_; ///< Query stamp of each cell's entries.
+            std::uint32_t stamp_ = 0; ///< Stamp of the current query.
+            std::vector<std::vector<std::uint32_t>> buckets_; ///< Dial queue: one bucket per f value.
+            std::vector<std::tuple<std::size_t, std::size_t>> path_; ///< Path found by the last query.
+            std::size_t expanded_ = 0; ///< Nodes expanded by the last query.
+    };
+}
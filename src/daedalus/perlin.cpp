@@ -0,0 +1,100 @@
+#include "perlin.hpp"
+#include "rng.hpp"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+namespace daedalus {
+
+    PerlinTable::PerlinTable(std::uint64_t seed) {
+        std::uint8_t base[256];
+        std::iota(base, base + 256, 0);
+        // Fisher-Yates driven by the library's fast generator
+        Xoshiro256pp rng(seed);
+        for (std::size_t k = 255; k > 0; k--) {
+            std::size_t swap_with = rng() % (k + 1);
+            std::uint8_t tmp = base[k];
+            base[k] = base[swap_with];
+            base[swap_with] = tmp;
+        }
+        for (std::size_t k = 0; k < 512; k++) {
+            perm_[k] = base[k & 255];
+        }
+    }
+
+    std::shared_ptr<const PerlinTable> PerlinTable::shared(std::uint64_t seed) {
+        static std::mutex cache_mutex;
+        static std::map<std::uint64_t, std::shared_ptr<const PerlinTable>> cache;
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        std::shared_ptr<const PerlinTable>& entry = cache[seed];
+        if (!entry) {
+            entry = std::make_shared<const PerlinTable>(seed);
+        }
+        return entry;
+    }
+
+    namespace {
+        float fade(float t) {
+            return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+        }
+
+        float lerp(float a, float b, float t) {
+            return a + t * (b - a);
+        }
+
+        // Eight-direction gradient selected by the hashed corner
+        float grad(std::uint8_t hash, float x, float y) {
+            switch (hash & 7) {
+                case 0: return x + y;
+                case 1: return x - y;
+                case 2: return -x + y;
+                case 3: return -x - y;
+                case 4: return x;
+                case 5: return -x;
+                case 6: return y;
+                default: return -y;
+            }
+        }
+    }
+
+    PerlinNoise::PerlinNoise(std::shared_ptr<const PerlinTable> table) :
+    table_(std::move(table)) {
+    }
+
+    float PerlinNoise::sample(float x, float y) const {
+        float fx = std::floor(x);
+        float fy = std::floor(y);
+        std::size_t xi = static_cast<std::size_t>(static_cast<long long>(fx)) & 255;
+        std::size_t yi = static_cast<std::size_t>(static_cast<long long>(fy)) & 255;
+        x -= fx;
+        y -= fy;
+        float u = fade(x);
+        float v = fade(y);
+
+        const PerlinTable& t = *table_;
+        std::uint8_t a = t.perm(xi) + yi;
+        std::uint8_t b = t.perm(xi + 1) + yi;
+        float n00 = grad(t.perm(a), x, y);
+        float n01 = grad(t.perm(a + 1), x, y - 1.0f);
+        float n10 = grad(t.perm(b), x - 1.0f, y);
+        float n11 = grad(t.perm(b + 1), x - 1.0f, y - 1.0f);
+
+        return lerp(lerp(n00, n10, u), lerp(n01, n11, u), v);
+    }
+
+    float PerlinNoise::fractal(float x, float y, int octaves, float lacunarity, float gain) const {
+        float sum = 0.0f;
+        float amplitude = 1.0f;
+        float total_amplitude = 0.0f;
+        for (int o = 0; o < octaves; o++) {
+            sum += amplitude * sample(x, y);
+            total_amplitude += amplitude;
+            amplitude *= gain;
+            x *= lacunarity;
+            y *= lacunarity;
+        }
+        return total_amplitude > 0.0f ? sum / total_amplitude : 0.0f;
+    }
+}
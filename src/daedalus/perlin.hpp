@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @file perlin.hpp
+ * @brief Perlin noise with shareable, seed-keyed gradient tables.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class PerlinTable
+     * @brief Immutable permutation table for Perlin noise, derived from a seed.
+     *
+     * Building the table costs a shuffle; sampling only reads it. Tables
+     * are immutable once built, so every dungeon generated from the same
+     * world seed shares one instance through shared() instead of
+     * rebuilding it per map.
+     */
+    class PerlinTable {
+        public:
+            /**
+             * @brief Build a table from a seed.
+             * @param seed Seed the permutation is derived from.
+             */
+            explicit PerlinTable(std::uint64_t seed);
+
+            /**
+             * @brief Get the shared table for a seed, building it on first use.
+             * @param seed Seed the permutation is derived from.
+             * @return Shared pointer to the immutable table.
+             */
+            static std::shared_ptr<const PerlinTable> shared(std::uint64_t seed);
+
+            /**
+             * @brief Look up the permutation at an index.
+             * @param index Index into the doubled table.
+             * @return The permutation value.
+             */
+            std::uint8_t perm(std::size_t index) const { return perm_[index & 511]; }
+
+        private:
+            std::uint8_t perm_[512]; /**< Permutation of 0..255, doubled to avoid masking twice */
+    };
+
+    /**
+     * @class PerlinNoise
+     * @brief Sampler for 2D Perlin noise over a shared table.
+     */
+    class PerlinNoise {
+        public:
+            /**
+             * @brief Constructor for a sampler over a shared table.
+             * @param table Table to sample with; must not be null.
+             */
+            explicit PerlinNoise(std::shared_ptr<const PerlinTable> table);
+
+            /**
+             * @brief Sample one octave of noise.
+             * @param x Sample x coordinate.
+             * @param y Sample y coordinate.
+             * @return Noise value in roughly [-1, 1].
+             */
+            float sample(float x, float y) const;
+
+            /**
+             * @brief Sample multi-octave fractal noise.
+             * @param x Sample x coordinate.
+             * @param y Sample y coordinate.
+             * @param octaves Number of octaves summed.
+             * @param lacunarity Frequency multiplier between octaves.
+             * @param gain Amplitude multiplier between octaves.
+             * @return Noise value in roughly [-1, 1].
+             */
+            float fractal(float x, float y, int octaves, float lacunarity = 2.0f, float gain = 0.5f) const;
+
+        private:
+            std::shared_ptr<const PerlinTable> table_; /**< Table the sampler reads */
+    };
+}
@@ -0,0 +1,100 @@
+#include "region_index.hpp"
+
+namespace daedalus {
+
+    RegionIndex::RegionIndex() :
+    region_ids_(0, 0) {
+    }
+
+    void RegionIndex::clear(std::size_t rows, std::size_t cols) {
+        region_ids_ = Array_2D<std::uint32_t>(rows, cols);
+        region_ids_.fill_rect(0, 0, rows, cols, NO_REGION);
+        regions_.clear();
+    }
+
+    std::uint32_t RegionIndex::region_at(std::size_t i, std::size_t j) const {
+        if (i >= region_ids_.rows() || j >= region_ids_.cols()) {
+            return NO_REGION;
+        }
+        return region_ids_(i, j);
+    }
+
+    std::uint32_t RegionIndex::add_rect_region(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1) {
+        std::uint32_t id = static_cast<std::uint32_t>(regions_.size());
+        region_ids_.fill_rect(r0, c0, r1, c1, id);
+
+        Region region;
+        region.id = id;
+        region.top = static_cast<std::uint32_t>(r0);
+        region.left = static_cast<std::uint32_t>(c0);
+        region.bottom = static_cast<std::uint32_t>(r1 - 1);
+        region.right = static_cast<std::uint32_t>(c1 - 1);
+        region.area = static_cast<std::uint32_t>((r1 - r0) * (c1 - c0));
+        region.centroid_i = (static_cast<float>(r0) + static_cast<float>(r1 - 1)) / 2.0f;
+        region.centroid_j = (static_cast<float>(c0) + static_cast<float>(c1 - 1)) / 2.0f;
+        regions_.push_back(std::move(region));
+        return id;
+    }
+
+    void RegionIndex::add_door(std::uint32_t region, std::size_t i, std::size_t j) {
+        if (region < regions_.size()) {
+            regions_[region].doors.push_back(std::make_tuple(i, j));
+        }
+    }
+
+    void RegionIndex::rebuild(const Array_2D<std::uint8_t>& tiles, std::uint8_t wall) {
+        const std::size_t nb_rows = tiles.rows();
+        const std::size_t nb_cols = tiles.cols();
+        clear(nb_rows, nb_cols);
+
+        std::vector<std::uint32_t> queue;
+        for (std::size_t si = 0; si < nb_rows; si++) {
+            for (std::size_t sj = 0; sj < nb_cols; sj++) {
+                if (tiles(si, sj) == wall || region_ids_(si, sj) != NO_REGION) {
+                    continue;
+                }
+                // Flood one component, accumulating its stats as we go
+                std::uint32_t id = static_cast<std::uint32_t>(regions_.size());
+                Region region;
+                region.id = id;
+                region.top = region.bottom = static_cast<std::uint32_t>(si);
+                region.left = region.right = static_cast<std::uint32_t>(sj);
+                region.area = 0;
+                double sum_i = 0.0;
+                double sum_j = 0.0;
+
+                queue.clear();
+                region_ids_(si, sj) = id;
+                queue.push_back(static_cast<std::uint32_t>(si * nb_cols + sj));
+                for (std::size_t head = 0; head < queue.size(); head++) {
+                    std::uint32_t cell = queue[head];
+                    std::size_t i = cell / nb_cols;
+                    std::size_t j = cell % nb_cols;
+                    region.area++;
+                    sum_i += i;
+                    sum_j += j;
+                    region.top = std::min(region.top, static_cast<std::uint32_t>(i));
+                    region.bottom = std::max(region.bottom, static_cast<std::uint32_t>(i));
+                    region.left = std::min(region.left, static_cast<std::uint32_t>(j));
+                    region.right = std::max(region.right, static_cast<std::uint32_t>(j));
+
+                    std::size_t neighbors[4][2] = {{i - 1, j}, {i + 1, j}, {i, j - 1}, {i, j + 1}};
+                    for (std::size_t n = 0; n < 4; n++) {
+                        std::size_t ni = neighbors[n][0];
+                        std::size_t nj = neighbors[n][1];
+                        if (ni >= nb_rows || nj >= nb_cols) {
+                            continue; // wrapped past an edge
+                        }
+                        if (tiles(ni, nj) != wall && region_ids_(ni, nj) == NO_REGION) {
+                            region_ids_(ni, nj) = id;
+                            queue.push_back(static_cast<std::uint32_t>(ni * nb_cols + nj));
+                        }
+                    }
+                }
+                region.centroid_i = static_cast<float>(sum_i / region.area);
+                region.centroid_j = static_cast<float>(sum_j / region.area);
+                regions_.push_back(std::move(region));
+            }
+        }
+    }
+}
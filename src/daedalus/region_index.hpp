@@ -0,0 +1,111 @@
+#pragma once
+
+#include "array_2D.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file region_index.hpp
+ * @brief Queryable spatial metadata recorded alongside tile generation.
+ */
+
+namespace daedalus {
+
+    /**
+     * @struct Region
+     * @brief One room or connected area of a dungeon.
+     */
+    struct Region {
+        std::uint32_t id; /**< Region id, the index into the region list */
+        std::uint32_t top; /**< First row of the bounding box */
+        std::uint32_t left; /**< First column of the bounding box */
+        std::uint32_t bottom; /**< Last row of the bounding box, inclusive */
+        std::uint32_t right; /**< Last column of the bounding box, inclusive */
+        std::uint32_t area; /**< Number of tiles in the region */
+        float centroid_i; /**< Row of the region's centroid */
+        float centroid_j; /**< Column of the region's centroid */
+        std::vector<std::tuple<std::size_t, std::size_t>> doors; /**< Corridor tiles adjoining the region */
+    };
+
+    /**
+     * @class RegionIndex
+     * @brief Room list plus a per-tile region-id layer.
+     *
+     * Generation records structure here as it carves, so spawn and loot
+     * systems query rooms directly instead of re-deriving them from the
+     * tile grid with a full connected-component scan. region_at is one
+     * array read; the room list iterates in carve order.
+     */
+    class RegionIndex {
+        public:
+            static constexpr std::uint32_t NO_REGION = 0xFFFFFFFFu; /**< Id of tiles outside any region */
+
+            /**
+             * @brief Constructor for an empty index.
+             */
+            RegionIndex();
+
+            /**
+             * @brief Drop all regions and resize the id layer for a new map.
+             * @param rows Number of rows in the dungeon.
+             * @param cols Number of columns in the dungeon.
+             */
+            void clear(std::size_t rows, std::size_t cols);
+
+            /**
+             * @brief Get the region id covering a tile.
+             * @param i Row index.
+             * @param j Column index.
+             * @return The region id, or NO_REGION.
+             */
+            std::uint32_t region_at(std::size_t i, std::size_t j) const;
+
+            /**
+             * @brief Get the recorded regions, in carve order.
+             * @return Vector of regions.
+             */
+            const std::vector<Region>& regions() const { return regions_; }
+
+            /**
+             * @brief Record a rectangular room and paint its tiles with the new id.
+             *
+             * Half-open bounds, matching fill_rect. A later overlapping
+             * room repaints the shared tiles with its own id; the earlier
+             * room's recorded rectangle is not shrunk.
+             *
+             * @param r0 First row of the room.
+             * @param c0 First column of the room.
+             * @param r1 One past the last row of the room.
+             * @param c1 One past the last column of the room.
+             * @return The new region's id.
+             */
+            std::uint32_t add_rect_region(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1);
+
+            /**
+             * @brief Record a door tile on a region.
+             * @param region Region the door belongs to.
+             * @param i Row index of the door tile.
+             * @param j Column index of the door tile.
+             */
+            void add_door(std::uint32_t region, std::size_t i, std::size_t j);
+
+            /**
+             * @brief Rebuild the index from a tile grid by connected-component labeling.
+             *
+             * Used by the generators whose areas emerge from noise instead
+             * of explicit carving; every 4-connected walkable component
+             * becomes one region. One O(rows*cols) sweep at generation
+             * time replaces a full grid scan per later query.
+             *
+             * @param tiles Tile grid to label.
+             * @param wall Tile value that blocks.
+             */
+            void rebuild(const Array_2D<std::uint8_t>& tiles, std::uint8_t wall);
+
+        private:
+            Array_2D<std::uint32_t> region_ids_; /**< Region id of every tile */
+            std::vector<Region> regions_; /**< The recorded regions */
+    };
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+/**
+ * @file rng.hpp
+ * @brief Random number generators used by the dungeon generation code.
+ */
+
+namespace daedalus {
+
+    /**
+     * @brief Mix a 64-bit value with the splitmix64 finalizer.
+     *
+     * Used to expand a single seed into generator state and to derive
+     * independent sub-seeds.
+     *
+     * @param x Value to mix; advanced by the splitmix64 increment.
+     * @return The mixed value.
+     */
+    inline std::uint64_t splitmix64(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @class Xoshiro256pp
+     * @brief Small fast random number generator (xoshiro256++).
+     *
+     * Satisfies UniformRandomBitGenerator, so it can be used with the
+     * standard distributions. Carries 32 bytes of state instead of the
+     * ~2.5 KB of std::mt19937, which matters when thousands of dungeons
+     * each hold their own generator.
+     */
+    class Xoshiro256pp {
+    public:
+        using result_type = std::uint64_t;
+
+        /**
+         * @brief Constructs a generator from a single seed.
+         *
+         * The state is expanded from the seed with splitmix64, as
+         * recommended by the xoshiro authors.
+         *
+         * @param seed Seed value.
+         */
+        explicit Xoshiro256pp(std::uint64_t seed = 0) {
+            this->seed(seed);
+        }
+
+        /**
+         * @brief Reseeds the generator.
+         *
+         * @param seed Seed value.
+         */
+        void seed(std::uint64_t seed) {
+            for (int i = 0; i < 4; i++) {
+                state_[i] = splitmix64(seed);
+            }
+        }
+
+        /**
+         * @brief Generates the next 64-bit value.
+         *
+         * @return A uniformly distributed 64-bit value.
+         */
+        result_type operator()() {
+            const std::uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+            const std::uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief Smallest value the generator can produce.
+         *
+         * @return Zero.
+         */
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        /**
+         * @brief Largest value the generator can produce.
+         *
+         * @return The maximum 64-bit value.
+         */
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+    private:
+        static std::uint64_t rotl(std::uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        std::uint64_t state_[4]; ///< The 256-bit generator state.
+    };
+
+    /**
+     * @class SeedSequence
+     * @brief Splittable seed derivation for reproducible distributed generation.
+     *
+     * A sequence wraps one 64-bit seed and derives independent child
+     * sequences by id, so a world seed fans out to per-dungeon seeds and
+     * those to per-chunk seeds with no shared state. The algorithm is
+     * stable and part of the format: the child state is
+     * splitmix64(parent_state XOR (0x9e3779b97f4a7c15 * (id + 1))), so
+     * any two nodes deriving the same path from the same world seed
+     * agree bit-for-bit, now and in future releases.
+     */
+    class SeedSequence {
+    public:
+        /**
+         * @brief Constructs a sequence from a seed.
+         *
+         * @param seed The seed, e.g. the world seed at the root.
+         */
+        explicit SeedSequence(std::uint64_t seed) :
+        state_(seed) {
+        };
+
+        /**
+         * @brief Derives the child sequence for an id.
+         *
+         * @param id The child id (dungeon id, chunk id, ...).
+         * @return The child sequence.
+         */
+        SeedSequence derive(std::uint64_t id) const {
+            std::uint64_t x = state_ ^ (0x9e3779b97f4a7c15ULL * (id + 1));
+            return SeedSequence(splitmix64(x));
+        }
+
+        /**
+         * @brief Gets the sequence's seed value.
+         *
+         * @return The seed, usable to construct a Dungeon or a generator.
+         */
+        std::uint64_t seed() const {
+            return state_;
+        }
+
+    private:
+        std::uint64_t state_; ///< The 64-bit seed the sequence wraps.
+    };
+
+    /**
+     * @brief The root of a seed hierarchy.
+     */
+    using WorldSeed = SeedSequence;
+
+    /**
+     * @brief Generator used by Dungeon.
+     *
+     * Defaults to Xoshiro256pp; define DAEDALUS_RNG_MT19937 to build the
+     * library against std::mt19937 instead, reproducing the dungeons of
+     * releases that predate the fast generator for a given seed.
+     */
+#ifdef DAEDALUS_RNG_MT19937
+    using DefaultRng = std::mt19937;
+#else
+    using DefaultRng = Xoshiro256pp;
+#endif
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * @file static_array_2D.hpp
+ * @brief A 2D array with compile-time dimensions and inline storage.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace daedalus {
+
+    /**
+     * @class StaticArray_2D
+     * @brief A 2D array whose dimensions are template parameters.
+     *
+     * Mirrors the Array_2D interface over an inline std::array, so there
+     * is no heap allocation and no runtime extent indirection: the index
+     * arithmetic constant-folds and loops over the grid unroll and
+     * vectorize against known bounds.
+     *
+     * @tparam T The type of elements stored in the array.
+     * @tparam Rows The number of rows in the array.
+     * @tparam Cols The number of columns in the array.
+     */
+    template <typename T, std::size_t Rows, std::size_t Cols>
+    class StaticArray_2D {
+    public:
+        /**
+         * @brief Constructs the array with value-initialized elements.
+         */
+        StaticArray_2D() :
+        data_() {
+        };
+
+        /**
+         * @brief Accesses the element at the given row and column.
+         *
+         * @param i The row index.
+         * @param j The column index.
+         * @return A reference to the element at the specified position.
+         */
+        T& operator()(std::size_t i, std::size_t j) {
+            return data_[i * Cols + j];
+        }
+
+        /**
+         * @brief Accesses the element at the given row and column (const version).
+         *
+         * @param i The row index.
+         * @param j The column index.
+         * @return A const reference to the element at the specified position.
+         */
+        const T& operator()(std::size_t i, std::size_t j) const {
+            return data_[i * Cols + j];
+        }
+
+        /**
+         * @brief Gets the number of rows in the array.
+         *
+         * @return The number of rows.
+         */
+        static constexpr std::size_t rows() {
+            return Rows;
+        }
+
+        /**
+         * @brief Gets the number of columns in the array.
+         *
+         * @return The number of columns.
+         */
+        static constexpr std::size_t cols() {
+            return Cols;
+        }
+
+        /**
+         * @brief Gets the total number of elements in the array.
+         *
+         * @return rows() * cols().
+         */
+        static constexpr std::size_t size() {
+            return Rows * Cols;
+        }
+
+        /**
+         * @brief Exports the data of the array to a vector.
+         *
+         * @param v The vector to which the data will be exported.
+         */
+        void export_data(std::vector<T>& v) const {
+            v.assign(data_.begin(), data_.end());
+        }
+
+        /**
+         * @brief Gets a pointer to the underlying row-major storage.
+         *
+         * @return A pointer to the first element.
+         */
+        T* data() {
+            return data_.data();
+        }
+
+        /**
+         * @brief Gets a pointer to the underlying row-major storage (const version).
+         *
+         * @return A const pointer to the first element.
+         */
+        const T* data() const {
+            return data_.data();
+        }
+
+        /**
+         * @brief Gets a pointer to the start of a row.
+         *
+         * @param i The row index.
+         * @return A pointer to the first element of the row.
+         */
+        T* row(std::size_t i) {
+            return data_.data() + i * Cols;
+        }
+
+        /**
+         * @brief Gets a pointer to the start of a row (const version).
+         *
+         * @param i The row index.
+         * @return A const pointer to the first element of the row.
+         */
+        const T* row(std::size_t i) const {
+            return data_.data() + i * Cols;
+        }
+
+        /**
+         * @brief Fills a rectangle with a value.
+         *
+         * The range is half-open and clamped to the array bounds, like
+         * Array_2D::fill_rect.
+         *
+         * @param r0 The first row of the rectangle.
+         * @param c0 The first column of the rectangle.
+         * @param r1 One past the last row of the rectangle.
+         * @param c1 One past the last column of the rectangle.
+         * @param value The value to fill with.
+         */
+        void fill_rect(std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1, const T& value) {
+            r1 = std::min(r1, Rows);
+            c1 = std::min(c1, Cols);
+            if (r0 >= r1 || c0 >= c1) {
+                return;
+            }
+            for (std::size_t i = r0; i < r1; i++) {
+                T* first = data_.data() + i * Cols;
+                std::fill(first + c0, first + c1, value);
+            }
+        }
+
+        /**
+         * @brief Counts the elements equal to a value.
+         *
+         * @param value The value to count.
+         * @return The number of matching elements.
+         */
+        std::size_t count(const T& value) const {
+            return std::count(data_.begin(), data_.end(), value);
+        }
+
+    private:
+        std::array<T, Rows * Cols> data_; ///< The inline data storage for the array.
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "dungeon.hpp"
+#include "generation_kernels.hpp"
+#include "static_array_2D.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+/**
+ * @file static_dungeon.hpp
+ * @brief A dungeon with compile-time dimensions.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class StaticDungeon
+     * @brief Dungeon whose dimensions are template parameters.
+     *
+     * For fixed-size maps (battle arenas, chunk templates) the tiles live
+     * inline in a StaticArray_2D, so there is no heap allocation and the
+     * generation kernels run over compile-time extents. Generation is
+     * shared with RogueDungeon through the kernels in
+     * generation_kernels.hpp; cellular automata is the supported method.
+     *
+     * @tparam Rows The number of rows in the dungeon.
+     * @tparam Cols The number of columns in the dungeon.
+     */
+    template <std::size_t Rows, std::size_t Cols>
+    class StaticDungeon {
+        public:
+            /**
+             * @brief Constructor to initialize the dungeon with a seed.
+             * @param seed Seed for random generation.
+             */
+            explicit StaticDungeon(unsigned long seed = std::chrono::system_clock::now().time_since_epoch().count()) :
+            rng_(seed) {
+            };
+
+            /**
+             * @brief Get the number of rows in the dungeon.
+             * @return Number of rows.
+             */
+            static constexpr std::size_t rows() { return Rows; }
+
+            /**
+             * @brief Get the number of columns in the dungeon.
+             * @return Number of columns.
+             */
+            static constexpr std::size_t cols() { return Cols; }
+
+            /**
+             * @brief Overloaded operator to access a tile at a given position.
+             * @param i Row index.
+             * @param j Column index.
+             * @return Reference to the tile at the given position.
+             */
+            const std::uint8_t& operator()(std::size_t i, std::size_t j) const {
+                return tiles_(i, j);
+            }
+
+            /**
+             * @brief Set a tile at a given position.
+             * @param i Row index.
+             * @param j Column index.
+             * @param tile Tile value to set.
+             */
+            void set_tile(std::size_t i, std::size_t j, std::uint8_t tile) {
+                tiles_(i, j) = tile;
+            }
+
+            /**
+             * @brief Check if a tile at a given position is a wall.
+             * @param i Row index.
+             * @param j Column index.
+             * @return True if the tile is a wall, false otherwise.
+             */
+            bool is_wall(std::size_t i, std::size_t j) const {
+                return tiles_(i, j) == static_cast<std::uint8_t>(DungeonTile::WALL);
+            }
+
+            /**
+             * @brief Get a read-only view of the tile storage, without copying.
+             * @return Const reference to the tile array.
+             */
+            const StaticArray_2D<std::uint8_t, Rows, Cols>& tiles_view() const {
+                return tiles_;
+            }
+
+            /**
+             * @brief Generate a random dungeon using a specified method.
+             *
+             * Cellular automata is the supported method for static
+             * dungeons: noise fill followed by five smoothing passes.
+             *
+             * @param method Method to use for dungeon generation.
+             */
+            void generate_random_dungeon(DungeonGenerationMethod method) {
+                if (method != DungeonGenerationMethod::CELLULAR_AUTOMATA) {
+                    std::cerr << "Method not available for this kind of dungeon" << std::endl;
+                    return;
+                }
+                std::uniform_int_distribution<int> noise_dist(0, 99);
+                for (std::size_t i = 0; i < Rows; i++) {
+                    for (std::size_t j = 0; j < Cols; j++) {
+                        bool wall = (i == 0 || j == 0 || i == Rows - 1 || j == Cols - 1 || noise_dist(rng_) < 45);
+                        tiles_(i, j) = static_cast<std::uint8_t>(wall ? DungeonTile::WALL : DungeonTile::FLOOR);
+                    }
+                }
+                for (int pass = 0; pass < 5; pass++) {
+                    generate_random_dungeon_cellular_automata_step();
+                }
+            }
+
+            /**
+             * @brief Perform a step of cellular automata dungeon generation.
+             */
+            void generate_random_dungeon_cellular_automata_step() {
+                cellular_automata_smooth(tiles_,
+                                         static_cast<std::uint8_t>(DungeonTile::WALL),
+                                         static_cast<std::uint8_t>(DungeonTile::FLOOR));
+            }
+
+        private:
+            StaticArray_2D<std::uint8_t, Rows, Cols> tiles_; /**< Inline 2D array representing the dungeon tiles */
+            DefaultRng rng_; /**< Random number generator */
+    };
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file stats.hpp
+ * @brief Library-wide counters for production introspection.
+ *
+ * Compiled in only when DAEDALUS_STATS is defined; without it the
+ * recording macros and the timer expand to nothing and the counters cost
+ * zero cycles and zero bytes on the hot paths. Snapshots are available in
+ * both builds so scraping code compiles unconditionally.
+ */
+
+namespace daedalus {
+
+    /**
+     * @struct StatsSnapshot
+     * @brief Point-in-time copy of the library counters.
+     */
+    struct StatsSnapshot {
+        static constexpr std::size_t NB_METHODS = 6; /**< Number of DungeonGenerationMethod values */
+
+        std::uint64_t tiles_written = 0; /**< Tiles written through set_tile, fill_rect and flood_fill */
+        std::uint64_t pathfinding_queries = 0; /**< find_path calls */
+        std::uint64_t pathfinding_expansions = 0; /**< Nodes expanded across all queries */
+        std::uint64_t generation_runs[NB_METHODS] = {}; /**< generate_random_dungeon calls per method */
+        std::uint64_t generation_time_ns[NB_METHODS] = {}; /**< Wall time spent generating per method */
+    };
+
+#ifdef DAEDALUS_STATS
+
+    /**
+     * @class Stats
+     * @brief Global atomic counters, active in DAEDALUS_STATS builds.
+     *
+     * Counters are relaxed atomics: cheap to bump from any thread, and a
+     * snapshot is a consistent-enough read for metrics scraping.
+     */
+    class Stats {
+    public:
+        /**
+         * @brief Gets the library-wide counter instance.
+         *
+         * @return Reference to the global counters.
+         */
+        static Stats& global() {
+            static Stats instance;
+            return instance;
+        }
+
+        /**
+         * @brief Copies the counters into a snapshot.
+         *
+         * @return The snapshot.
+         */
+        StatsSnapshot snapshot() const {
+            StatsSnapshot s;
+            s.tiles_written = tiles_written.load(std::memory_order_relaxed);
+            s.pathfinding_queries = pathfinding_queries.load(std::memory_order_relaxed);
+            s.pathfinding_expansions = pathfinding_expansions.load(std::memory_order_relaxed);
+            for (std::size_t m = 0; m < StatsSnapshot::NB_METHODS; m++) {
+                s.generation_runs[m] = generation_runs[m].load(std::memory_order_relaxed);
+                s.generation_time_ns[m] = generation_time_ns[m].load(std::memory_order_relaxed);
+            }
+            return s;
+        }
+
+        /**
+         * @brief Resets every counter to zero.
+         */
+        void reset() {
+            tiles_written = 0;
+            pathfinding_queries = 0;
+            pathfinding_expansions = 0;
+            for (std::size_t m = 0; m < StatsSnapshot::NB_METHODS; m++) {
+                generation_runs[m] = 0;
+                generation_time_ns[m] = 0;
+            }
+        }
+
+        std::atomic<std::uint64_t> tiles_written{0}; ///< Tiles written through the mutation paths.
+        std::atomic<std::uint64_t> pathfinding_queries{0}; ///< find_path calls.
+        std::atomic<std::uint64_t> pathfinding_expansions{0}; ///< Nodes expanded across all queries.
+        std::atomic<std::uint64_t> generation_runs[StatsSnapshot::NB_METHODS] = {}; ///< Generation calls per method.
+        std::atomic<std::uint64_t> generation_time_ns[StatsSnapshot::NB_METHODS] = {}; ///< Generation wall time per method.
+    };
+
+    /**
+     * @class StatsGenerationTimer
+     * @brief Scope timer crediting its lifetime to a generation method.
+     */
+    class StatsGenerationTimer {
+    public:
+        /**
+         * @brief Starts timing a generation run.
+         *
+         * @param method The DungeonGenerationMethod value, as an index.
+         */
+        explicit StatsGenerationTimer(int method) :
+        method_(method),
+        start_(std::chrono::steady_clock::now()) {
+        };
+
+        /**
+         * @brief Stops timing and records the run.
+         */
+        ~StatsGenerationTimer() {
+            if (method_ >= 0 && method_ < static_cast<int>(StatsSnapshot::NB_METHODS)) {
+                auto elapsed = std::chrono::steady_clock::now() - start_;
+                Stats::global().generation_runs[method_].fetch_add(1, std::memory_order_relaxed);
+                Stats::global().generation_time_ns[method_].fetch_add(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                    std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        int method_; ///< Method the run is credited to.
+        std::chrono::steady_clock::time_point start_; ///< Start of the run.
+    };
+
+/** @brief Adds to a library counter; compiles to nothing without DAEDALUS_STATS. */
+#define DAEDALUS_STATS_ADD(field, n) (daedalus::Stats::global().field.fetch_add((n), std::memory_order_relaxed))
+/** @brief Times a generation run; compiles to nothing without DAEDALUS_STATS. */
+#define DAEDALUS_STATS_GENERATION_TIMER(method) daedalus::StatsGenerationTimer daedalus_stats_timer_(static_cast<int>(method))
+
+#else
+
+    /**
+     * @class Stats
+     * @brief Stub counters for builds without DAEDALUS_STATS.
+     */
+    class Stats {
+    public:
+        /**
+         * @brief Gets the library-wide counter instance.
+         *
+         * @return Reference to the global stub.
+         */
+        static Stats& global() {
+            static Stats instance;
+            return instance;
+        }
+
+        /**
+         * @brief Gets an all-zero snapshot.
+         *
+         * @return The snapshot.
+         */
+        StatsSnapshot snapshot() const {
+            return StatsSnapshot();
+        }
+
+        /**
+         * @brief No-op.
+         */
+        void reset() {
+        }
+    };
+
+#define DAEDALUS_STATS_ADD(field, n) ((void)0)
+#define DAEDALUS_STATS_GENERATION_TIMER(method) ((void)0)
+
+#endif
+}
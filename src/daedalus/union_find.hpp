@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/**
+ * @file union_find.hpp
+ * @brief A union-find (disjoint set) structure over dense integer ids.
+ */
+
+namespace daedalus {
+
+    /**
+     * @class UnionFind
+     * @brief Disjoint sets over the ids 0 to n - 1.
+     *
+     * Uses path halving and union by size, so find and unite are
+     * effectively constant time. Sets can only be merged, never split;
+     * callers that need to disconnect elements rebuild the structure.
+     */
+    class UnionFind {
+    public:
+        /**
+         * @brief Constructs the structure with every id in its own set.
+         *
+         * @param n The number of ids.
+         */
+        explicit UnionFind(std::size_t n = 0) {
+            reset(n);
+        };
+
+        /**
+         * @brief Puts every id back in its own set, resizing to n ids.
+         *
+         * @param n The number of ids.
+         */
+        void reset(std::size_t n) {
+            parent_.resize(n);
+            std::iota(parent_.begin(), parent_.end(), 0);
+            size_.assign(n, 1);
+        }
+
+        /**
+         * @brief Finds the representative of an id's set.
+         *
+         * @param x The id.
+         * @return The representative id.
+         */
+        std::uint32_t find(std::uint32_t x) {
+            while (parent_[x] != x) {
+                parent_[x] = parent_[parent_[x]];
+                x = parent_[x];
+            }
+            return x;
+        }
+
+        /**
+         * @brief Merges the sets of two ids.
+         *
+         * @param a The first id.
+         * @param b The second id.
+         */
+        void unite(std::uint32_t a, std::uint32_t b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (size_[a] < size_[b]) {
+                std::swap(a, b);
+            }
+            parent_[b] = a;
+            size_[a] += size_[b];
+        }
+
+        /**
+         * @brief Checks whether two ids are in the same set.
+         *
+         * @param a The first id.
+         * @param b The second id.
+         * @return True if the ids are connected.
+         */
+        bool connected(std::uint32_t a, std::uint32_t b) {
+            return find(a) == find(b);
+        }
+
+    private:
+        std::vector<std::uint32_t> parent_; ///< Parent of each id; roots point to themselves.
+        std::vector<std::uint32_t> size_; ///< Set size, maintained for roots.
+    };
+}